@@ -6,30 +6,77 @@
 #include <iostream>
 #include <sstream>
 #include <assert.h>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <map>
-#include <set>
+#include <deque>
 #include <vector>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
 
 /***
  * bst & avl Current Available Methods (suppose "Type elt;"):
  * (00) bst()/avl(), bst(elt)/avl(elt), bst(bst)/avl(bst), bst(intializer_list)/avl(intializer_list),
- *      bst(vector, BST::PREORDER [OR BST::POSTORDER])/avl(vector, BST::PREORDER [OR BST::POSTORDER]),
- *      ~bst()/~avl()
- * (01) insert(elt), insert(intializer_list), insert(bst/avl)
+ *      bst(vector, BST::PREORDER [OR BST::INORDER OR BST::POSTORDER])/avl(vector, ...),
+ *      bst(first_iterator, last_iterator)/avl(first_iterator, last_iterator), ~bst()/~avl()
+ * (01) insert(elt), insert(intializer_list), insert(bst/avl), emplace(args...)
  * (02) remove(elt), remove(intializer_list), remove(bst/avl), remove_if(Unary_Predicate_function)
  * (03) clear()
- * (04) preorder_vector(), postorder_vector(), inorder_vector()
+ * (04) preorder_vector(), postorder_vector(), inorder_vector(), freeze()
  * (05) min(), max()
  * (06) has(elt)
  * (07) size(), sizeO1(), height(), level_of(elt)
  * (08) show(), show_preorder(), show_inorder(), show_postorder()
  * (09) show_diagram()
  * (10) begin(), cbegin(), crbegin(), rbegin(), end(), cend(), crend(), rend()
+ * (11) select(k), rank(elt), count_range(lo_elt, hi_elt)
+ * (12) preorder(), inorder(), postorder(), levelorder()
+ * (13) avl only: union_with(avl), intersect_with(avl), difference_with(avl),
+ *      & BST::union_of(avl, avl), BST::intersection_of(avl, avl), BST::difference_of(avl, avl)
+ * (14) lower_bound(elt), upper_bound(elt), floor(elt), ceil(elt), predecessor(elt), successor(elt),
+ *      range(lo_elt, hi_elt)
+ *
+ * BST::persistent_avl<Type> (path-copying versions, published atomically):
+ * (00) persistent_avl(), persistent_avl(intializer_list), persistent_avl(persistent_avl),
+ *      persistent_avl(version), persistent_avl(first_iterator, last_iterator)
+ * (01) snapshot(), publish(version)
+ * (02) insert(elt), remove(elt), clear()
+ * (03) size(), height(), has(elt), inorder_vector()
+ * (04) version: begin(), end(), size(), height(), has(elt), min(), max(), select(k), rank(elt),
+ *      inorder_vector(), show()
+ *
+ * BST::concurrent_bst<Type> (unbalanced, lock-free reads, per-node locks for writes):
+ * (00) concurrent_bst(), concurrent_bst(intializer_list)
+ * (01) insert(elt), emplace(args...), remove(elt)
+ * (02) has(elt), size(), inorder_vector()
+ *
+ * BST::btree<Type, B> (B-tree w/ up to B sorted elts per node, default: 1 cache line's worth):
+ * (00) btree(), btree(elt), btree(btree), btree(intializer_list), btree(first_iterator, last_iterator)
+ * (01) insert(elt), insert(intializer_list), insert(btree), emplace(args...)
+ * (02) remove(elt), remove(intializer_list), remove(btree), remove_if(Unary_Predicate_function), clear()
+ * (03) inorder_vector(), freeze(), min(), max(), has(elt), size(), sizeO1(), height(), level_of(elt)
+ * (04) show(), show_inorder(), begin(), cbegin(), crbegin(), rbegin(), end(), cend(), crend(), rend()
+ * (05) lower_bound(elt), upper_bound(elt), floor(elt), ceil(elt), predecessor(elt), successor(elt),
+ *      range(lo_elt, hi_elt)
+ *
+ * BST::frozen<Type> (read-only Eytzinger-layout array, made by "freeze()" on a bst/avl/btree):
+ * (00) frozen(), frozen(vector)
+ * (01) has(elt), lower_bound(elt), & batched: has(vector), lower_bound(vector)
+ * (02) size(), min(), max(), inorder_vector(), show()
  *
  * NOTES:
  *   => BST::bst && BST::avl => BOTH HAVE THE SAME PUBLIC INTERFACE!
  *   => Datatypes in BST's class objects must support '>', '<', & '=='
+ *   => Nodes come from a BST::node_pool by default: bst<Type, BST::heap_allocator>
+ *      (or avl<...>) allocates each node individually w/ new/delete instead
  */
 
 // Binary Search Tree class templates
@@ -40,92 +87,371 @@ namespace BST {
 
   enum states {PREORDER, INORDER, POSTORDER};
 
-  template <typename Type>
+  template <typename Type> class frozen; // read-only snapshots made by "freeze()"
+
+
+  // Node allocator policies: "allocate()" returns raw storage for 1 Node & 
+  // "deallocate()" takes it back. If "bulk_release" is true, "release()" frees
+  // every node at once (w/o running their destructors). "splice(other)" takes 
+  // over the nodes of another policy object, so they can be freed by this one.
+
+  // Default policy: nodes are carved out of contiguous slabs (each twice the 
+  // size of the last, up to 4096 nodes), & freed nodes are threaded onto a free
+  // list for reuse. "release()" frees the slabs, so clearing a tree of trivially
+  // destructible data never has to visit its nodes.
+  template <typename Node>
+  class node_pool {
+    union slot { slot *next; alignas(Node) unsigned char storage[sizeof(Node)]; };
+    struct slab { slab *next; std::size_t capacity; };
+    slab *slabs = nullptr;
+    slot *free_list = nullptr, *cursor = nullptr, *slab_end = nullptr; // cursor: next unused slot
+    std::size_t next_capacity = 32;
+
+    // slots start at the 1st suitably aligned address past each slab's header
+    static const std::size_t header_bytes = (sizeof(slab) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+    // thread the current slab's unused slots onto the free list (before leaving it)
+    void free_unused_slots() {
+      while(cursor != slab_end) cursor->next = free_list, free_list = cursor++;
+    }
+    void add_slab(const std::size_t capacity) {
+      free_unused_slots();
+      slab *sp = static_cast<slab*>(::operator new(header_bytes + capacity * sizeof(slot)));
+      sp->next = slabs, sp->capacity = capacity, slabs = sp;
+      cursor = reinterpret_cast<slot*>(reinterpret_cast<char*>(sp) + header_bytes), slab_end = cursor + capacity;
+    }
+
+  public:
+    static const bool bulk_release = true;
+
+    node_pool() = default;
+    node_pool(const node_pool &) = delete;            // each tree owns its own pool
+    node_pool &operator=(const node_pool &) = delete;
+    node_pool(node_pool &&pool) noexcept { swap(pool); } // moved trees take their slabs along
+    node_pool &operator=(node_pool &&pool) noexcept { swap(pool); return *this; }
+    ~node_pool() { release(); }
+
+    void swap(node_pool &pool) noexcept {
+      std::swap(slabs, pool.slabs), std::swap(free_list, pool.free_list), std::swap(cursor, pool.cursor);
+      std::swap(slab_end, pool.slab_end), std::swap(next_capacity, pool.next_capacity);
+    }
+
+    Node *allocate() {
+      if(free_list != nullptr) {
+        slot *sp = free_list;
+        free_list = free_list->next;
+        return reinterpret_cast<Node*>(sp);
+      }
+      if(cursor == slab_end) {
+        add_slab(next_capacity);
+        if(next_capacity < 4096) next_capacity *= 2;
+      }
+      return reinterpret_cast<Node*>(cursor++);
+    }
+    void deallocate(Node *np) {
+      slot *sp = reinterpret_cast<slot*>(np);
+      sp->next = free_list, free_list = sp;
+    }
+    // Ensures the next "n" allocations won't need another slab (counting free nodes &
+    // the unused rest of the current slab, which a new slab keeps on the free list)
+    void reserve(const std::size_t n) {
+      std::size_t available = static_cast<std::size_t>(slab_end - cursor);
+      for(slot *sp = free_list; sp != nullptr && available < n; sp = sp->next) ++available;
+      if(available < n) add_slab(n - available);
+    }
+    // Frees every slab at once: all nodes from this pool become invalid
+    void release() {
+      while(slabs != nullptr) {
+        slab *next = slabs->next;
+        ::operator delete(slabs);
+        slabs = next;
+      }
+      free_list = cursor = slab_end = nullptr;
+      next_capacity = 32;
+    }
+    // Takes over another pool's slabs & free nodes (including the unused rest of
+    // its current slab), leaving it empty
+    void splice(node_pool &pool) {
+      if(this == &pool || pool.slabs == nullptr) return;
+      pool.free_unused_slots();
+      slab *last_slab = pool.slabs;
+      while(last_slab->next != nullptr) last_slab = last_slab->next;
+      last_slab->next = slabs, slabs = pool.slabs;
+      if(pool.free_list != nullptr) {
+        slot *last_free = pool.free_list;
+        while(last_free->next != nullptr) last_free = last_free->next;
+        last_free->next = free_list, free_list = pool.free_list;
+      }
+      pool.slabs = nullptr, pool.free_list = pool.cursor = pool.slab_end = nullptr;
+      pool.next_capacity = 32;
+    }
+  };
+
+
+  // Alternative policy: every node is its own heap allocation
+  template <typename Node>
+  struct heap_allocator {
+    static const bool bulk_release = false;
+    Node *allocate()              { return static_cast<Node*>(::operator new(sizeof(Node))); }
+    void deallocate(Node *np)     { ::operator delete(np); }
+    void reserve(const std::size_t) {}
+    void release() {}
+    void splice(heap_allocator &) {}
+  };
+
+
+  template <typename Type, template<typename> class Allocator = node_pool>
   class bst {
   protected:
-    // bst Node Struct, Enum'd Printing Orders, & Data Set
-    struct NODE { Type data; NODE *left = nullptr, *right = nullptr; };
+    // bst Node Struct (w/ parent links for iteration & cached subtree heights/sizes), 
+    // Root, & Node Allocator
+    struct NODE { 
+      Type data; NODE *left = nullptr, *right = nullptr, *parent = nullptr; 
+      long long height = 1; // # of levels in the subtree rooted here
+      long long nodes  = 1; // # of nodes in the subtree rooted here
+      template<typename... Args> explicit NODE(Args&&... args) : data(std::forward<Args>(args)...) {}
+    };
     NODE *root = nullptr;
-    std::set<Type> data_set; // (used w/ std::map to print tree's diagram)
+    Allocator<NODE> pool;
 
 
     // Private Methods
-    // copy 1 bst to another
-    void copy_bst(const NODE *np) {
-      if(np == nullptr) return;
-      insert(np->data);
-      data_set.insert(np->data);
-      copy_bst(np->left), copy_bst(np->right);
-    }
-    // alloc a new node given data
-    NODE *mknode(const Type e) {
-      NODE *np = new NODE;
-      np->data = e;
-      return np;
+    // clone another bst's exact shape into this empty one in O(n) (iterative: the 
+    // stack only holds right subtrees still to copy, thus O(height) entries)
+    void copy_bst(const NODE *src) {
+      struct pending_subtree { const NODE *src; NODE *parent; NODE **link; };
+      std::vector<pending_subtree> pending;
+      if(src != nullptr) pending.push_back({src, nullptr, &root});
+      pool.reserve(subtree_size(src));
+      while(!pending.empty()) {
+        const pending_subtree subtree = pending.back();
+        pending.pop_back();
+        NODE *np = *subtree.link = mknode(subtree.src->data);
+        np->parent = subtree.parent, np->height = subtree.src->height, np->nodes = subtree.src->nodes;
+        if(subtree.src->right != nullptr) pending.push_back({subtree.src->right, np, &np->right});
+        if(subtree.src->left != nullptr)  pending.push_back({subtree.src->left, np, &np->left});
+      }
     }
-    // bst-wide node deletion (recursive)
+    // alloc a new node, constructing its data in place from "args"
+    template<typename... Args>
+    NODE *mknode(Args&&... args) {
+      NODE *np = pool.allocate();
+      try {
+        return new (np) NODE(std::forward<Args>(args)...);
+      } catch(...) {
+        pool.deallocate(np);
+        throw;
+      }
+    }
+    // free a node alloc'd by "mknode"
+    void freenode(NODE *np) {
+      np->~NODE();
+      pool.deallocate(np);
+    }
+    // bst-wide node deletion (iterative: each node's postorder successor is 
+    // found before freeing it, & never lies w/in its subtree)
     void destroy_bst(NODE *np) { 
-      if(np == nullptr) return;
-      destroy_bst(np->left), destroy_bst(np->right);
-      data_set.erase(np->data);
-      delete np;
+      for(np = postorder_first(np); np != nullptr;) {
+        NODE *next = postorder_successor(np);
+        freenode(np);
+        np = next;
+      }
+    }
+    // frees every node: pools of trivially destructible data release their slabs
+    // outright, rather than visiting each node
+    void destroy_all_nodes() {
+      if(!Allocator<NODE>::bulk_release || !std::is_trivially_destructible<Type>::value)
+        destroy_bst(root);
+      pool.release(), root = nullptr;
+    }
+    // Bulk Building (O(n)): 
+    // sort & dedup "elts" (in parallel chunks for large inputs) unless already strictly ascending
+    static void sort_unique(std::vector<Type> &elts) {
+      bool strictly_ascending = true;
+      for(std::size_t i = 1; i < elts.size() && strictly_ascending; ++i)
+        strictly_ascending = elts[i-1] < elts[i];
+      if(strictly_ascending) return;
+      std::size_t threads = std::thread::hardware_concurrency();
+      if(threads < 2 || elts.size() < 65536) {
+        std::sort(elts.begin(), elts.end());
+      } else { // sort "threads" chunks concurrently, then merge adjacent pairs of sorted runs
+        std::vector<std::size_t> bounds;
+        for(std::size_t t = 0; t <= threads; ++t) bounds.push_back(elts.size() * t / threads);
+        std::vector<std::thread> workers;
+        for(std::size_t t = 0; t < threads; ++t)
+          workers.emplace_back([&elts, &bounds, t]{ std::sort(elts.begin() + bounds[t], elts.begin() + bounds[t+1]); });
+        for(auto &worker : workers) worker.join();
+        for(std::size_t width = 1; width < threads; width *= 2) {
+          workers.clear();
+          for(std::size_t t = 0; t + width < threads; t += 2 * width) {
+            const std::size_t lo = bounds[t], mid = bounds[t + width], hi = bounds[std::min(t + 2 * width, threads)];
+            workers.emplace_back([&elts, lo, mid, hi]{ std::inplace_merge(elts.begin() + lo, elts.begin() + mid, elts.begin() + hi); });
+          }
+          for(auto &worker : workers) worker.join();
+        }
+      }
+      elts.erase(std::unique(elts.begin(), elts.end()), elts.end());
+    }
+    // link a perfectly balanced subtree of sorted elts [lo,hi) under "parent" (recursive),
+    // moving each elt into its node
+    NODE *build_balanced(std::vector<Type> &elts, const std::size_t lo, const std::size_t hi, NODE *parent) {
+      if(lo == hi) return nullptr;
+      const std::size_t mid = lo + (hi - lo) / 2;
+      NODE *np = mknode(std::move(elts[mid]));
+      np->parent = parent;
+      np->left = build_balanced(elts, lo, mid, np), np->right = build_balanced(elts, mid + 1, hi, np);
+      refresh_node(np);
+      return np;
+    }
+    // replace the bst w/ a perfectly balanced one (thus also a valid avl) of sorted,
+    // unique "elts" (moved from), whose nodes are all allocated in 1 batch
+    void build_from_sorted(std::vector<Type> &elts) {
+      destroy_all_nodes();
+      pool.reserve(elts.size());
+      root = build_balanced(elts, 0, elts.size(), nullptr);
     }
 
 
-    // add a non-nullptr node to bst (recursive)
-    virtual NODE *addnode(NODE *np, const Type e) {
-      if(np == nullptr) {
-        data_set.insert(e);
-        return mknode(e);
-      }
-      if(e < np->data)
-        np->left = addnode(np->left, e), data_set.insert(e);
-      else if(e > np->data)
-        np->right = addnode(np->right, e), data_set.insert(e);
+    // point a subtree's root at its new parent (subtrees are re-linked bottom-up)
+    static NODE *adopt(NODE *child, NODE *parent) {
+      if(child != nullptr) child->parent = parent;
+      return child;
+    }
+
+
+    // inorder neighbors of a node (iterative, via parent links)
+    static NODE *leftmost(NODE *np) {
+      if(np != nullptr) while(np->left != nullptr) np = np->left;
       return np;
     }
+    static NODE *rightmost(NODE *np) {
+      if(np != nullptr) while(np->right != nullptr) np = np->right;
+      return np;
+    }
+    static NODE *successor(NODE *np) {
+      if(np->right != nullptr) return leftmost(np->right);
+      while(np->parent != nullptr && np == np->parent->right) np = np->parent;
+      return np->parent;
+    }
+    static NODE *predecessor(NODE *np) {
+      if(np->left != nullptr) return rightmost(np->left);
+      while(np->parent != nullptr && np == np->parent->left) np = np->parent;
+      return np->parent;
+    }
+    // pre/postorder neighbors of a node (iterative, via parent links)
+    static NODE *preorder_successor(NODE *np) {
+      if(np->left != nullptr)  return np->left;
+      if(np->right != nullptr) return np->right;
+      while(np->parent != nullptr && (np == np->parent->right || np->parent->right == nullptr)) np = np->parent;
+      return (np->parent == nullptr) ? nullptr : np->parent->right;
+    }
+    static NODE *postorder_first(NODE *np) { // deepest leaf reached favoring left children
+      if(np != nullptr) while(np->left != nullptr || np->right != nullptr) np = (np->left != nullptr) ? np->left : np->right;
+      return np;
+    }
+    static NODE *postorder_successor(NODE *np) {
+      NODE *parent = np->parent;
+      if(parent != nullptr && np == parent->left && parent->right != nullptr) return postorder_first(parent->right);
+      return parent;
+    }
 
 
-    // rmv node from bst w/ given data 'e' (recursive).
-    // replaces rmvd node w/ either the greatest val in its 
-    // left subtree or least val in its right subtree
-    virtual NODE *rmnode(NODE *np, const Type e, bool &found) {
-      if(np == nullptr) return nullptr;
-      if(e < np->data)
-        np->left = rmnode(np->left, e, found);
-      else if(e > np->data)
-        np->right = rmnode(np->right, e, found);
-      else {
-        found = true;
-        // if no left/right child, shift up right/left subtree (or nullptr)
-        if(np->left == nullptr || np->right == nullptr) { 
-          NODE *temp = (np->left == nullptr) ? np->right : np->left;
-          delete np;
-          return temp;
+    // find where 'e' belongs (iterative): returns the empty link to attach it at (also
+    // setting "parent" to its parent-to-be), or nullptr if the bst already has 'e'
+    NODE **find_link(const Type &e, NODE *&parent) {
+      NODE **link = &root;
+      parent = nullptr;
+      while(*link != nullptr) {
+        if(e < (*link)->data)      parent = *link, link = &parent->left;
+        else if(e > (*link)->data) parent = *link, link = &parent->right;
+        else return nullptr;
+      }
+      return link;
+    }
+    // attach a new node at "link", then retrace from its parent up
+    void link_node(NODE **link, NODE *parent, NODE *np) {
+      *link = np, np->parent = parent;
+      retrace(parent);
+    }
+    // insert 'e' (copied or moved into its node only if not already present)
+    template<typename Elt>
+    void insert_elt(Elt &&e) {
+      NODE *parent;
+      NODE **link = find_link(e, parent);
+      if(link != nullptr) link_node(link, parent, mknode(std::forward<Elt>(e)));
+    }
+
+
+    // point np's parent (or root) at "child" instead
+    void replace_child(NODE *np, NODE *child) {
+      NODE *parent = np->parent;
+      if(parent == nullptr)         root = child;
+      else if(parent->left == np)   parent->left = child;
+      else                          parent->right = child;
+      adopt(child, parent);
+    }
+    // rmv a node from bst (iterative): a node w/ both left & right subtrees is replaced
+    // by the least node in its right subtree (relinked, so no elt is ever copied &
+    // iterators to other nodes stay valid). Then retrace from the lowest changed node.
+    void unlink_node(NODE *np) {
+      NODE *changed;
+      if(np->left == nullptr || np->right == nullptr) { // shift up right/left subtree (or nullptr)
+        replace_child(np, (np->left == nullptr) ? np->right : np->left);
+        changed = np->parent;
+      } else {
+        NODE *next = leftmost(np->right);
+        if(next == np->right) {
+          changed = next;
+        } else {
+          changed = next->parent;
+          changed->left = adopt(next->right, changed);
+          next->right = adopt(np->right, next);
         }
-        // "np" has both left & right subtrees, thus swap np's value w/ 
-        // the least value in its right subtree & rmv said "least value" from the right subtree
-        NODE *temp = np->right;
-        while(temp->left != nullptr) temp = temp->left;
-        np->data = temp->data;
-        np->right = rmnode(np->right, temp->data, found);
+        next->left = adopt(np->left, next);
+        replace_child(np, next);
       }
-      return np;
+      freenode(np);
+      retrace(changed);
     }
 
 
-    // count nodes/height/level-of-elt of bst (recursive)
-    long long count_nodes(const NODE *np) const {
-      if(np == nullptr) return 0;
-      return 1 + count_nodes(np->left) + count_nodes(np->right);
+    // Retrace Hook: called w/ the parent of each inserted node, & the lowest node 
+    // whose subtree lost a node, to restore the cached heights/sizes (& any balance 
+    // invariants of derived trees) from there up to the root
+    virtual void retrace(NODE *np) {
+      for(; np != nullptr; np = np->parent) refresh_node(np);
     }
-    long long subtree_height(const NODE *np) const {
-      if(np == nullptr) return 0;
-      long long left_height  = subtree_height(np->left), 
-                right_height = subtree_height(np->right);
-      return 1 + ((left_height > right_height) ? left_height : right_height);
+
+
+    // read the cached height/size of a subtree (O(1)), & find the level of an elt (iterative)
+    static long long subtree_height(const NODE *np) {
+      return (np == nullptr) ? 0 : np->height;
+    }
+    static long long subtree_size(const NODE *np) {
+      return (np == nullptr) ? 0 : np->nodes;
+    }
+    // recompute np's cached height & size from its children's (after they changed)
+    static void refresh_node(NODE *np) {
+      const long long left_height = subtree_height(np->left), right_height = subtree_height(np->right);
+      np->height = 1 + ((left_height > right_height) ? left_height : right_height);
+      np->nodes  = 1 + subtree_size(np->left) + subtree_size(np->right);
+    }
+    // nearest nodes to 'e' (iterative, O(height)): the least node above 'e' (or 
+    // at it, if "inclusive") & the greatest node below 'e' (or at it), else nullptr
+    NODE *least_above(const Type &e, const bool inclusive) const {
+      NODE *bound = nullptr;
+      for(NODE *np = root; np != nullptr;)
+        if(e < np->data || (inclusive && !(np->data < e))) bound = np, np = np->left;
+        else np = np->right;
+      return bound;
+    }
+    NODE *greatest_below(const Type &e, const bool inclusive) const {
+      NODE *bound = nullptr;
+      for(NODE *np = root; np != nullptr;)
+        if(np->data < e || (inclusive && !(e < np->data))) bound = np, np = np->right;
+        else np = np->left;
+      return bound;
     }
-    long long count_level_of(const Type e) const {
+    long long count_level_of(const Type &e) const {
       long long bst_level = 0;
       NODE *np = root;
       while(np != nullptr) {
@@ -137,31 +463,31 @@ namespace BST {
     }
 
 
-    // traverse bst adding elts to "order_vector" in either pre-or-post order (recursive)
-    void get_bst_ordered_elts(std::vector<Type> &order_vector, const NODE *np, const int pushing_order) const {
-      if(np == nullptr) return;
-      if(pushing_order == PREORDER) order_vector.push_back(np->data);  // SLR
-      get_bst_ordered_elts(order_vector, np->left, pushing_order);
-      get_bst_ordered_elts(order_vector, np->right, pushing_order);
-      if(pushing_order == POSTORDER) order_vector.push_back(np->data); // LRS
+    // 1st & next node of a subtree's pre, in, or postorder traversal (iterative)
+    static NODE *first_in_order(NODE *np, const int order) {
+      if(order == INORDER)   return leftmost(np);
+      if(order == POSTORDER) return postorder_first(np);
+      return np;
+    }
+    static NODE *next_in_order(NODE *np, const int order) {
+      if(order == INORDER)   return successor(np);
+      if(order == POSTORDER) return postorder_successor(np);
+      return preorder_successor(np);
     }
-    // returns a vector either in pre-or-post order (as per "pushing_order")
+    // returns a vector either in pre-or-post order (as per "pushing_order", iterative)
     std::vector<Type> prepost_ordered_vector(const int pushing_order) const {
       std::vector<Type> order_vector;
-      order_vector.reserve(data_set.size());
-      get_bst_ordered_elts(order_vector, root, pushing_order);
+      order_vector.reserve(subtree_size(root));
+      for(NODE *np = first_in_order(root, pushing_order); np != nullptr; np = next_in_order(np, pushing_order))
+        order_vector.push_back(np->data);
       return order_vector;
     }
 
 
-    // output bst nodes in the given order (recursive)
-    void show_nodes(const NODE *np, const int printing_order, const std::string seperator, std::ostream &os) const {
-      if(np == nullptr) return;
-      if(printing_order == PREORDER) os << np->data << seperator;  // SLR
-      show_nodes(np->left, printing_order, seperator, os);
-      if(printing_order == INORDER) os << np->data << seperator;   // LSR
-      show_nodes(np->right, printing_order, seperator, os);
-      if(printing_order == POSTORDER) os << np->data << seperator; // LRS
+    // output bst nodes in the given order (iterative)
+    void show_nodes(const int printing_order, const std::string seperator, std::ostream &os) const {
+      for(NODE *np = first_in_order(root, printing_order); np != nullptr; np = next_in_order(np, printing_order))
+        os << np->data << seperator;
     }
 
 
@@ -189,7 +515,7 @@ namespace BST {
     long long max_data_OP_width() {
       long long max_width = 0, width;
       std::ostringstream outstr;
-      for(auto it = data_set.begin(); it != data_set.end(); ++it) {
+      for(auto it = begin(); it != end(); ++it) {
         outstr << *it; // ouput data as std::string
         if((width = outstr.str().size()) > max_width) // save widest data O/P length 
           max_width = width;
@@ -198,7 +524,7 @@ namespace BST {
       return max_width;
     }
     // returns std::string of data point, prefixing data widths < "max_data_width" w/ '_'s
-    std::string data_string(Type data, long long max_data_width) {
+    std::string data_string(const Type &data, long long max_data_width) {
       std::ostringstream outstr, data_ostr;
       data_ostr << data;
       std::string data_str = data_ostr.str();
@@ -207,26 +533,38 @@ namespace BST {
     }
 
 
-    // Returns Level Of A Given Pre-Or-Post Ordered Elt At Index "n" W/in "ordered_vect"
-    long long map_prepost_order_levels(long long idx, const long long n, const std::vector<Type> &ordered_vect, const long long increment) const {
-      if(idx == n) return 0;
-      Type last_seen = ordered_vect[idx];
-      if(last_seen < ordered_vect[n])
-        while(idx != n && ordered_vect[(idx += increment)] < last_seen);
-      else
-        while(idx != n && ordered_vect[(idx += increment)] > last_seen);
-      return 1 + map_prepost_order_levels(idx, n, ordered_vect, increment);
-    }
-    // Returns std::multimap Of std::pair(level,elt) From Either Pre-Or-Post 
-    // Ordered std::vector "ordered_vect"'s elts (W/ Order Denoted By "order_type")
-    std::multimap<long long,Type> sort_ordered_levels(const std::vector<Type> ordered_vect, const int order_type) const {
-      std::multimap<long long,Type> leveled_map;
-      long long start = 0, increment = 1, end = ordered_vect.size(); // as if order_type == PREORDER
-      if(order_type == POSTORDER)
-        start = ordered_vect.size()-1, increment = -1, end = -1;
-      for(long long i = start; i != end; i += increment)
-        leveled_map.insert(std::make_pair(map_prepost_order_levels(start, i, ordered_vect, increment), ordered_vect[i]));
-      return leveled_map;
+    // Rebuilds the exact bst whose preorder (or postorder, read backwards) is "elts"
+    // in O(n). "pending" holds the path of nodes that may still receive a right (or
+    // left) subtree: each elt pops off every pending node it comes after, becoming 
+    // the last such node's right (or left) child, else the left (or right) child of
+    // the top pending node. Returns false (leaving the bst empty) if "elts" isn't 
+    // such an order of unique elts.
+    bool build_from_order(const std::vector<Type> &elts, const int order_type) {
+      destroy_all_nodes();
+      const bool pre = (order_type == PREORDER);
+      const std::size_t n = elts.size();
+      auto comes_after = [pre](const Type &a, const Type &b) { return pre ? b < a : a < b; };
+      std::vector<NODE*> pending, built;
+      built.reserve(n), pool.reserve(n);
+      NODE *bound = nullptr; // last node whose far subtree was entered
+      for(std::size_t i = 0; i < n; ++i) {
+        const Type &e = elts[pre ? i : n - 1 - i];
+        if(bound != nullptr && !comes_after(e, bound->data)) { destroy_all_nodes(); return false; }
+        NODE *parent = nullptr;
+        while(!pending.empty() && comes_after(e, pending.back()->data)) parent = pending.back(), pending.pop_back();
+        if(!pending.empty() && !comes_after(pending.back()->data, e)) { destroy_all_nodes(); return false; } // duplicate
+        NODE *np = mknode(e);
+        if(parent != nullptr)
+          (pre ? parent->right : parent->left) = np, np->parent = bound = parent;
+        else if(!pending.empty())
+          (pre ? pending.back()->left : pending.back()->right) = np, np->parent = pending.back();
+        else
+          root = np;
+        pending.push_back(np), built.push_back(np);
+      }
+      // children were built after their parents, so refresh heights & sizes in reverse
+      for(std::size_t i = built.size(); i-- > 0;) refresh_node(built[i]);
+      return true;
     }
 
 
@@ -234,59 +572,182 @@ namespace BST {
   public:
     // Constructors/Assignment/Destructor 
     bst() = default;
-    bst(const Type e)    { root = mknode(e), data_set.insert(e); }
+    bst(const Type &e)   { root = mknode(e); }
+    bst(Type &&e)        { root = mknode(std::move(e)); }
     bst(const bst &tree) { copy_bst(tree.root); }
+    bst(bst &&tree) noexcept : root(tree.root), pool(std::move(tree.pool)) { tree.root = nullptr; }
     bst(const std::initializer_list<Type>&e) { insert(e); }
-    bst(const std::vector<Type> ordered_vect, int order_type) { 
-      if(order_type != PREORDER && order_type != POSTORDER) {
+    // (INORDER vectors are bulk built into a perfectly balanced bst, sorting them 1st if needed)
+    bst(const std::vector<Type> &ordered_vect, int order_type) { 
+      if(order_type != PREORDER && order_type != INORDER && order_type != POSTORDER) {
         std::cerr << "\n\033[1m" << __FILE__ << ":" << __func__ << ":" << __LINE__ 
           << ":\033[31mERROR:\033[0m\033[1m namespace::BST::bst CTOR'S ORDERED"
-          << " VECTOR DENOTED NEITHER PRE NOR POST\033[0m\n    –> DEFAULTING TO PRE.\n\n";
+          << " VECTOR DENOTED NEITHER PRE, IN, NOR POST\033[0m\n    –> DEFAULTING TO PRE.\n\n";
         order_type = PREORDER;
       }
-      auto leveled_map = sort_ordered_levels(ordered_vect, order_type);
-      for(auto e : leveled_map)
-        insert(e.second);
+      if(order_type == INORDER) {
+        std::vector<Type> elts(ordered_vect);
+        sort_unique(elts), build_from_sorted(elts);
+        return;
+      }
+      if(build_from_order(ordered_vect, order_type)) return;
+      // not a valid order (ie has duplicates): insert elts in order, roots 1st
+      if(order_type == PREORDER) for(auto it = ordered_vect.begin(); it != ordered_vect.end(); ++it) insert(*it);
+      else for(auto it = ordered_vect.rbegin(); it != ordered_vect.rend(); ++it) insert(*it);
+    }
+    // Bulk builds a perfectly balanced bst from any range of elts (sorted or not) in O(n) 
+    // (plus an O(n log n) parallel sort if unsorted)
+    template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    bst(InputIt first, InputIt last) {
+      std::vector<Type> elts(first, last);
+      sort_unique(elts), build_from_sorted(elts);
     }
-    virtual ~bst() { destroy_bst(root), root = nullptr; }
+    virtual ~bst() { destroy_all_nodes(); }
     bst &operator=(const bst &tree) {
-      destroy_bst(root), root = nullptr, copy_bst(tree.root);
+      if(this == &tree) return *this;
+      destroy_all_nodes(), copy_bst(tree.root);
+      return *this;
+    }
+    bst &operator=(bst &&tree) noexcept {
+      if(this == &tree) return *this;
+      destroy_all_nodes();
+      root = tree.root, tree.root = nullptr;
+      pool = std::move(tree.pool);
       return *this;
     }
 
 
-    // Iterators To The In-Order std::set Of Data
-    typename std::set<Type>::iterator               begin()   const {return data_set.begin();}
-    typename std::set<Type>::iterator               end()     const {return data_set.end();}
-    typename std::set<Type>::const_iterator         cbegin()  const {return data_set.cbegin();}
-    typename std::set<Type>::const_iterator         cend()    const {return data_set.cend();}
-    typename std::set<Type>::reverse_iterator       rbegin()  const {return data_set.rbegin();}
-    typename std::set<Type>::reverse_iterator       rend()    const {return data_set.rend();}
-    typename std::set<Type>::const_reverse_iterator crbegin() const {return data_set.crbegin();}
-    typename std::set<Type>::const_reverse_iterator crend()   const {return data_set.crend();}
+    // Bidirectional Inorder Iterator Over The bst's Own Nodes (Constant, Like std::set's).
+    // Stays valid until its node is removed, or its bst is cleared/destroyed.
+    class const_iterator {
+      friend class bst;
+      NODE *np = nullptr;
+      const bst *tree = nullptr; // to step back from "end()"
+      const_iterator(NODE *node, const bst *owner) : np(node), tree(owner) {}
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = Type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const Type*;
+      using reference         = const Type&;
+
+      const_iterator() = default;
+      reference operator*()  const { return np->data; }
+      pointer   operator->() const { return &np->data; }
+      const_iterator &operator++() { np = successor(np); return *this; }
+      const_iterator &operator--() { np = (np == nullptr) ? rightmost(tree->root) : predecessor(np); return *this; }
+      const_iterator operator++(int) { const_iterator it = *this; ++*this; return it; }
+      const_iterator operator--(int) { const_iterator it = *this; --*this; return it; }
+      bool operator==(const const_iterator &it) const { return np == it.np; }
+      bool operator!=(const const_iterator &it) const { return np != it.np; }
+    };
+    using iterator               = const_iterator;
+    using reverse_iterator       = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Inorder Iterators
+    iterator               begin()   const {return iterator(leftmost(root), this);}
+    iterator               end()     const {return iterator(nullptr, this);}
+    const_iterator         cbegin()  const {return begin();}
+    const_iterator         cend()    const {return end();}
+    reverse_iterator       rbegin()  const {return reverse_iterator(end());}
+    reverse_iterator       rend()    const {return reverse_iterator(begin());}
+    const_reverse_iterator crbegin() const {return rbegin();}
+    const_reverse_iterator crend()   const {return rend();}
+
+
+    // Lazy Forward Iterator Over The bst's Nodes In Pre/In/Post/Level Order.
+    // Pre/in/postorder steps walk parent links (O(1) space, no recursion);
+    // levelorder's keeps a queue of the nodes still to visit (O(bst width)).
+    // Stays valid until a node is inserted/removed, or its bst is cleared/destroyed.
+    enum { LEVELORDER = POSTORDER + 1 }; // extends BST::states for "order_iterator"
+    class order_iterator {
+      friend class bst;
+      NODE *np = nullptr;
+      int order = INORDER; // BST::states value, else levelorder
+      std::deque<NODE*> queued; // levelorder only
+      order_iterator(NODE *node, const int traversal_order) : np(node), order(traversal_order) {}
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = Type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const Type*;
+      using reference         = const Type&;
+
+      order_iterator() = default;
+      reference operator*()  const { return np->data; }
+      pointer   operator->() const { return &np->data; }
+      order_iterator &operator++() {
+        if(order != LEVELORDER) np = next_in_order(np, order);
+        else {
+          if(np->left != nullptr)  queued.push_back(np->left);
+          if(np->right != nullptr) queued.push_back(np->right);
+          np = nullptr;
+          if(!queued.empty()) np = queued.front(), queued.pop_front();
+        }
+        return *this;
+      }
+      order_iterator operator++(int) { order_iterator it = *this; ++*this; return it; }
+      bool operator==(const order_iterator &it) const { return np == it.np; }
+      bool operator!=(const order_iterator &it) const { return np != it.np; }
+    };
+    // Range Of A Single Traversal (for use w/ range-based for loops & <algorithm>)
+    class traversal {
+      friend class bst;
+      order_iterator first;
+      explicit traversal(const order_iterator &it) : first(it) {}
+    public:
+      order_iterator begin() const { return first; }
+      order_iterator end()   const { return order_iterator(); }
+    };
+
+    // Traversal Ranges (elts are visited lazily, thus loops may break early)
+    traversal preorder()   const {return traversal(order_iterator(root, PREORDER));}
+    traversal inorder()    const {return traversal(order_iterator(leftmost(root), INORDER));}
+    traversal postorder()  const {return traversal(order_iterator(postorder_first(root), POSTORDER));}
+    traversal levelorder() const {return traversal(order_iterator(root, LEVELORDER));}
 
 
     // Insert/Remove A Particular Elt, Clear Entire bst
-    virtual void insert(const Type e) { root = addnode(root, e); }
-    virtual void insert(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)insert(*it);}
-    virtual void insert(const bst &tree){for(auto it=tree.begin();it!=tree.end();++it)insert(*it);}
-    virtual bool remove(const Type e) {
-      bool found = false;
-      root = rmnode(root, e, found);
-      if(found) data_set.erase(e);
-      if(data_set.size() == 0) root = nullptr;
-      return found;
+    // (all iterative: each elt is only ever constructed inside its node)
+    void insert(const Type &e) { insert_elt(e); }
+    void insert(Type &&e)      { insert_elt(std::move(e)); }
+    void insert(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)insert(*it);}
+    void insert(const bst &tree){for(auto it=tree.begin();it!=tree.end();++it)insert(*it);}
+    bool remove(const Type &e) {
+      NODE *np = root;
+      while(np != nullptr && (e < np->data || e > np->data))
+        np = (e < np->data) ? np->left : np->right;
+      if(np == nullptr) return false;
+      unlink_node(np);
+      return true;
+    }
+    void remove(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)remove(*it);}
+    void remove(const bst &tree){for(auto it=tree.begin();it!=tree.end();++it)remove(*it);}
+    void clear() { destroy_all_nodes(); }
+
+
+    // Construct An Elt In Place From "args" (returns whether it was inserted: if the 
+    // bst already had it, the new elt is destroyed)
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+      NODE *parent, *np = mknode(std::forward<Args>(args)...);
+      NODE **link = find_link(np->data, parent);
+      if(link == nullptr) { freenode(np); return false; }
+      link_node(link, parent, np);
+      return true;
     }
-    virtual void remove(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)remove(*it);}
-    virtual void remove(const bst &tree){for(auto it=tree.begin();it!=tree.end();++it)remove(*it);}
-    void clear() { destroy_bst(root), root = nullptr; }
 
     
-    // Remove Data Satisfying A Particular Condition
+    // Remove Data Satisfying A Particular Condition (in 1 inorder pass: removals
+    // relink nodes rather than moving elts, so the next node stays valid)
     template<typename Unary_Predicate>
     void remove_if(Unary_Predicate condition) {
-      for(auto it = data_set.begin(); it != data_set.end();)
-        condition(*it) ? remove(*it),data_set.erase(*it),it=data_set.begin() : ++it;
+      for(NODE *np = leftmost(root); np != nullptr;) {
+        NODE *next = successor(np);
+        if(condition(np->data)) unlink_node(np);
+        np = next;
+      }
     }
 
 
@@ -297,11 +758,13 @@ namespace BST {
     // Return Inorder Elt Vector
     std::vector<Type> inorder_vector()   const {
       std::vector<Type> inord_vect;
-      inord_vect.reserve(data_set.size());
-      for(auto e : data_set)
-        inord_vect.push_back(e);
+      inord_vect.reserve(subtree_size(root));
+      for(auto it = begin(); it != end(); ++it)
+        inord_vect.push_back(*it);
       return inord_vect;
     }
+    // Immutable, Contiguous Eytzinger-Layout Copy For Fast Read-Only Lookups
+    frozen<Type> freeze() const { return frozen<Type>(inorder_vector()); }
 
 
     // Min/Max Values In bst (iterative).
@@ -320,33 +783,83 @@ namespace BST {
 
 
     // Check Whether bst Contains Given 'e' Data (iterative)
-    bool has(const Type e) const { return (count_level_of(e) != -1); }
+    bool has(const Type &e) const { return (count_level_of(e) != -1); }
+
+
+    // Nearest Elts To 'e' (iterative, O(height)): "end()" if there's none
+    const_iterator lower_bound(const Type &e) const { return const_iterator(least_above(e, true), this);     } // least >= e
+    const_iterator upper_bound(const Type &e) const { return const_iterator(least_above(e, false), this);    } // least > e
+    const_iterator ceil(const Type &e)        const { return lower_bound(e);                                  } // least >= e
+    const_iterator floor(const Type &e)       const { return const_iterator(greatest_below(e, true), this);  } // greatest <= e
+    const_iterator successor(const Type &e)   const { return upper_bound(e);                                  } // least > e
+    const_iterator predecessor(const Type &e) const { return const_iterator(greatest_below(e, false), this); } // greatest < e
+
+
+    // Range Of The Elts In [lo,hi), In Order (for use w/ range-based for loops & 
+    // <algorithm>): lazy & w/o copying, thus O(height + k) to visit its k elts.
+    // Stays valid until a node is inserted/removed, or its bst is cleared/destroyed.
+    class elt_range {
+      friend class bst;
+      const_iterator first, last;
+      elt_range(const const_iterator &lo_it, const const_iterator &hi_it) : first(lo_it), last(hi_it) {}
+    public:
+      const_iterator begin() const { return first; }
+      const_iterator end()   const { return last;  }
+    };
+    elt_range range(const Type &lo, const Type &hi) const {
+      const const_iterator last = lower_bound(hi);
+      return elt_range((lo < hi) ? lower_bound(lo) : last, last);
+    }
+
+
+    // Order Statistics Via Cached Subtree Sizes (iterative, O(height)):
+    // k-th Smallest Elt (0-indexed), # Of Elts < 'e', & # Of Elts In [lo,hi)
+    Type select(long long k) const {
+      assert(k >= 0 && k < size());
+      NODE *np = root;
+      for(;;) {
+        const long long left_size = subtree_size(np->left);
+        if(k == left_size) return np->data;
+        if(k < left_size) np = np->left;
+        else k -= left_size + 1, np = np->right;
+      }
+    }
+    long long rank(const Type &e) const {
+      long long elts_less = 0;
+      for(NODE *np = root; np != nullptr;)
+        if(np->data < e) elts_less += subtree_size(np->left) + 1, np = np->right;
+        else np = np->left;
+      return elts_less;
+    }
+    long long count_range(const Type &lo, const Type &hi) const {
+      return (lo < hi) ? rank(hi) - rank(lo) : 0;
+    }
 
 
     // Count Nodes/Height/Level-Of-Elt Of bst
-    long long size()                 const { return count_nodes(root);    }
-    long long sizeO1()               const { return data_set.size();      } // O(1), no algorithm
-    long long height()               const { return subtree_height(root); }
-    long long level_of(const Type e) const { return count_level_of(e);    } // -1 if DNE
+    long long size()                 const { return subtree_size(root);   } // O(1), cached count
+    long long sizeO1()               const { return subtree_size(root);   } // (same as "size()")
+    long long height()               const { return subtree_height(root); } // O(1), cached
+    long long level_of(const Type &e) const { return count_level_of(e);    } // -1 if DNE
 
 
     // Output Each Node In bst
     void show_preorder(const std::string seperator = " ", std::ostream &os = std::cout)  const {
-      show_nodes(root, PREORDER, seperator, os);
+      show_nodes(PREORDER, seperator, os);
     }
     void show_inorder(const std::string seperator = " ", std::ostream &os = std::cout)   const {
-      show_nodes(root, INORDER, seperator, os);
+      show_nodes(INORDER, seperator, os);
     }
     void show_postorder(const std::string seperator = " ", std::ostream &os = std::cout) const {
-      show_nodes(root, POSTORDER, seperator, os);
+      show_nodes(POSTORDER, seperator, os);
     }
     void show(const std::string seperator = " ", std::ostream &os = std::cout)           const {
-      show_nodes(root, INORDER, seperator, os); // inorder, LSR
+      show_nodes(INORDER, seperator, os); // inorder, LSR
     }
 
 
     // Overloaded I/O Stream Friends
-    friend std::ostream &operator<<(std::ostream &os, bst &tree) { tree.show(" ", os); return os; }
+    friend std::ostream &operator<<(std::ostream &os, const bst &tree) { tree.show(" ", os); return os; }
     friend std::istream &operator>>(std::istream &is, bst &tree) { 
       Type e; is >> e; is.get(); tree.insert(e); return is; 
     }
@@ -355,7 +868,7 @@ namespace BST {
     // Output ASCII Diagram Of bst
     void show_diagram(std::ostream &os = std::cout) {
       os << std::endl;
-      if(data_set.size() == 0) return;
+      if(root == nullptr) return;
       const long long max_width = max_data_OP_width();
       long long underscores, initial_padding, data_spacing;
       std::string data_str, uscore_str, space_str, 
@@ -363,7 +876,7 @@ namespace BST {
 
       // create a multimap sorted by elt-level keys w/ elt-data values
       std::multimap<long long, Type>data_multimap;
-      for(auto it = data_set.begin(); it != data_set.end(); ++it)
+      for(auto it = begin(); it != end(); ++it)
         data_multimap.insert({level_of(*it), *it}); 
 
       // print the bst tree's diagram via ASCII art
@@ -426,64 +939,55 @@ namespace BST {
 
 
 
-  template <typename Type>
-  class avl : public bst<Type> {
+  template <typename Type, template<typename> class Allocator = node_pool>
+  class avl : public bst<Type, Allocator> {
   private:
     // NODE Structure
-    using NODE = typename bst<Type>::NODE;
+    using NODE = typename bst<Type, Allocator>::NODE;
 
 
-    // Right & Left Rotations
+    // Right & Left Rotations (the new subtree head inherits np's parent)
     NODE *rotate_right(NODE *np) {
       NODE *subtree_head  = np->left;
       NODE *subtree_child = subtree_head->right;
       subtree_head->right = np;
-      np->left = subtree_child;
+      np->left = this->adopt(subtree_child, np);
+      subtree_head->parent = np->parent, np->parent = subtree_head;
+      this->refresh_node(np), this->refresh_node(subtree_head);
       return subtree_head;
     }
     NODE *rotate_left(NODE *np) {
       NODE *subtree_head  = np->right;
       NODE *subtree_child = subtree_head->left;
       subtree_head->left = np;
-      np->right = subtree_child;
+      np->right = this->adopt(subtree_child, np);
+      subtree_head->parent = np->parent, np->parent = subtree_head;
+      this->refresh_node(np), this->refresh_node(subtree_head);
       return subtree_head;
     }
 
 
-    // Balance Factor For A Node
+    // Balance Factor For A Node (O(1) via cached heights)
     long long balance_factor(NODE *np) {
       if(np == nullptr) return 0;
       return this->subtree_height(np->left) - this->subtree_height(np->right);
     }
 
 
-    // Add a Given Elt & Re-Balance As Needed
-    NODE *addnode(NODE *np, const Type e) {
-      // New Elt
-      if(np == nullptr) {
-        this->data_set.insert(e);
-        return this->mknode(e);
-      }
-
-      // Traverse Tree
-      if(e < np->data)
-        np->left = addnode(np->left, e);
-      else if(e > np->data)
-        np->right = addnode(np->right, e);
-      else
-        return np; // AVL already has elt
-
-      // Rotate AVL As Needed
+    // Rotate A Subtree As Needed, Returning Its (New) Head
+    NODE *rebalance(NODE *np) {
       const long long np_balance_factor = balance_factor(np);
-      if(np_balance_factor > 1 && e < np->left->data)     // LEFT LEFT
+      const long long left_child_balance_factor = balance_factor(np->left);
+      const long long right_child_balance_factor = balance_factor(np->right);
+      if(np_balance_factor > 1 && left_child_balance_factor >= 0)    // LEFT LEFT
         return rotate_right(np);
-      if(np_balance_factor < -1 && e > np->right->data)   // RIGHT RIGHT
+      if(np_balance_factor < -1 && right_child_balance_factor <= 0)  // RIGHT RIGHT
         return rotate_left(np);
-      if(np_balance_factor > 1 && e > np->left->data) {   // LEFT RIGHT
+      if(np_balance_factor > 1 && left_child_balance_factor < 0) {   // LEFT RIGHT
         np->left = rotate_left(np->left);
         return rotate_right(np);
-      } 
-      if(np_balance_factor < -1 && e < np->right->data) { // RIGHT LEFT
+      }
+      if(np_balance_factor < -1 && right_child_balance_factor > 0) { // RIGHT LEFT
         np->right = rotate_right(np->right);
         return rotate_left(np);
       }
@@ -491,113 +995,1445 @@ namespace BST {
     }
 
 
-    // Rmv a Given Elt & Re-Balance As Needed
-    NODE *rmnode(NODE *np, const Type e, bool &found) {
-      // Elt Not Found
-      if(np == nullptr) return np;
-
-      // Traverse Tree
-      if(e < np->data)
-        np->left = rmnode(np->left, e, found);
-      else if(e > np->data)
-        np->right = rmnode(np->right, e, found);
-      else {
-        found = true;
-        // if missing either child (or both) shift up other side (or nullptr)
-        if(np->left == nullptr || np->right == nullptr) { 
-          NODE *temp = (np->left != nullptr) ? np->left : np->right;
-          if(temp == nullptr) // no children, nothing to shift up
-            temp = np, np = nullptr;
-          else
-            *np = *temp; // shift up non-nullptr child
-          delete temp;
-        } else { // "np" has both children
-          // swap np's value w/ least value in right subtree & rmv said value
-          NODE *temp = np->right;
-          while(temp->left != nullptr) temp = temp->left;
-          np->data = temp->data;
-          np->right = rmnode(np->right, temp->data, found);
-        }
+    // Re-Balance From np Up To The Head Of Its (Sub)Tree, Returning The (New) Head 
+    // (after an insertion, a child of an unbalanced node is never itself balanced, 
+    // so the removal cases above also cover insertions)
+    NODE *rebalance_up(NODE *np) {
+      for(;;) {
+        NODE *parent = np->parent;
+        const bool is_left_child = (parent != nullptr && np == parent->left);
+        this->refresh_node(np);
+        np = rebalance(np);
+        if(parent == nullptr) return np;
+        (is_left_child ? parent->left : parent->right) = np;
+        np = parent;
       }
+    }
+    // Re-Balance From An Inserted Node's Parent (Or A Removal's Lowest Changed Node)
+    void retrace(NODE *np) {
+      if(np != nullptr) this->root = rebalance_up(np);
+    }
 
-      // If No Children, No Rotations
-      if(np == nullptr) return np; 
 
-      // Rotate Tree As Needed
-      const long long np_balance_factor = balance_factor(np);
-      const long long left_child_balance_factor = balance_factor(np->left);
-      const long long right_child_balance_factor = balance_factor(np->right);
-      if(np_balance_factor > 1 && left_child_balance_factor >= 0)    // LEFT LEFT
-        return rotate_right(np);
-      if(np_balance_factor < -1 && right_child_balance_factor <= 0)  // RIGHT RIGHT
-        return rotate_left(np);
-      if(np_balance_factor > 1 && left_child_balance_factor < 0) {   // LEFT RIGHT
-        np->left = rotate_left(np->left);
-        return rotate_right(np);
+    // Split & Join (on detached subtrees: their heads' parents are nullptr)
+    // detach np's subtrees, leaving np a lone node
+    void expose(NODE *np, NODE *&left, NODE *&right) {
+      left = this->adopt(np->left, nullptr), right = this->adopt(np->right, nullptr);
+      np->left = np->right = nullptr;
+      this->refresh_node(np);
+    }
+    // join subtrees w/ elts "left" < "key"'s < "right" in O(|height difference|):
+    // "key" is linked into the taller subtree's inner spine where heights first match
+    NODE *join(NODE *left, NODE *key, NODE *right) {
+      const long long left_height = this->subtree_height(left), right_height = this->subtree_height(right);
+      NODE *parent = nullptr, *np;
+      if(left_height > right_height + 1) {
+        for(np = left; this->subtree_height(np) > right_height + 1; np = np->right) parent = np;
+        key->left = this->adopt(np, key), key->right = this->adopt(right, key);
+        parent->right = this->adopt(key, parent);
+      } else if(right_height > left_height + 1) {
+        for(np = right; this->subtree_height(np) > left_height + 1; np = np->left) parent = np;
+        key->right = this->adopt(np, key), key->left = this->adopt(left, key);
+        parent->left = this->adopt(key, parent);
+      } else {
+        key->left = this->adopt(left, key), key->right = this->adopt(right, key);
+        key->parent = nullptr;
       }
-      if(np_balance_factor < -1 && right_child_balance_factor > 0) { // RIGHT LEFT
-        np->right = rotate_right(np->right);
-        return rotate_left(np);
+      return rebalance_up(key);
+    }
+    // join subtrees w/ elts "left" < "right", using left's greatest node as the key
+    NODE *join(NODE *left, NODE *right) {
+      if(left == nullptr) return right;
+      if(right == nullptr) return left;
+      NODE *key = this->rightmost(left), *above = key->parent;
+      if(above == nullptr) {
+        left = this->adopt(key->left, nullptr);
+      } else {
+        above->right = this->adopt(key->left, above);
+        left = rebalance_up(above);
       }
-      return np;
+      key->left = nullptr;
+      return join(left, key, right);
+    }
+    // split subtree "np" into elts < 'e' ("left") & > 'e' ("right") in O(height),
+    // returning e's (lone) node, or nullptr if absent (recursive)
+    NODE *split(NODE *np, const Type &e, NODE *&left, NODE *&right) {
+      if(np == nullptr) { left = right = nullptr; return nullptr; }
+      NODE *np_left, *np_right, *found;
+      expose(np, np_left, np_right);
+      if(e < np->data) {
+        found = split(np_left, e, left, right);
+        right = join(right, np, np_right);
+      } else if(e > np->data) {
+        found = split(np_right, e, left, right);
+        left = join(np_left, np, left);
+      } else {
+        left = np_left, right = np_right, found = np;
+      }
+      return found;
     }
 
 
-    // Copy subtree to AVL, Balancing tree as needed
-    void copy_avl(const NODE *np) {
-      if(np == nullptr) return;
-      insert(np->data);
-      copy_avl(np->left), copy_avl(np->right);
+    // Join-Based Set Operations (recursive): t1 is split around t2's head, & both
+    // sides are combined independently -- on 2 threads while the subtrees are large
+    // & "forks" > 0. Nodes dropped from the result are collected in "discarded".
+    static const long long parallel_cutoff = 1 << 15; // min nodes in both subtrees to fork
+    static int max_forks() {
+      int forks = 0;
+      for(unsigned threads = std::thread::hardware_concurrency(); threads > 1; threads >>= 1) ++forks;
+      return (forks == 0) ? 0 : forks + 1; // 2x more tasks than threads, to even out loads
+    }
+    // run "left_task" & "right_task", the 1st on a new thread if "fork"
+    template<typename LeftTask, typename RightTask>
+    static void fork_join(const bool fork, std::vector<NODE*> &discarded, LeftTask left_task, RightTask right_task) {
+      if(!fork) { left_task(discarded), right_task(discarded); return; }
+      std::vector<NODE*> left_discarded;
+      std::thread left_worker([&]{ left_task(left_discarded); });
+      right_task(discarded);
+      left_worker.join();
+      discarded.insert(discarded.end(), left_discarded.begin(), left_discarded.end());
+    }
+    // merge t2 (also from this avl's pool) into t1, keeping t1's node for shared elts
+    NODE *union_nodes(NODE *t1, NODE *t2, std::vector<NODE*> &discarded, const int forks) {
+      if(t1 == nullptr) return t2;
+      if(t2 == nullptr) return t1;
+      const bool fork = forks > 0 && this->subtree_size(t1) + this->subtree_size(t2) >= parallel_cutoff;
+      NODE *l1, *r1, *l2, *r2;
+      expose(t2, l2, r2);
+      NODE *key = split(t1, t2->data, l1, r1);
+      if(key != nullptr) discarded.push_back(t2);
+      else               key = t2;
+      fork_join(fork, discarded, 
+        [&](std::vector<NODE*> &d) { l1 = union_nodes(l1, l2, d, forks - fork); },
+        [&](std::vector<NODE*> &d) { r1 = union_nodes(r1, r2, d, forks - fork); });
+      return join(l1, key, r1);
+    }
+    // keep ("intersect") or drop t1's elts that are also in the read-only subtree t2
+    NODE *filter_nodes(const bool intersect, NODE *t1, const NODE *t2, std::vector<NODE*> &discarded, const int forks) {
+      if(t1 == nullptr) return nullptr;
+      if(t2 == nullptr) {
+        if(!intersect) return t1;
+        discarded.push_back(t1);
+        return nullptr;
+      }
+      const bool fork = forks > 0 && this->subtree_size(t1) + this->subtree_size(t2) >= parallel_cutoff;
+      NODE *l1, *r1;
+      NODE *found = split(t1, t2->data, l1, r1);
+      fork_join(fork, discarded, 
+        [&](std::vector<NODE*> &d) { l1 = filter_nodes(intersect, l1, t2->left, d, forks - fork); },
+        [&](std::vector<NODE*> &d) { r1 = filter_nodes(intersect, r1, t2->right, d, forks - fork); });
+      if(found != nullptr && intersect) return join(l1, found, r1);
+      if(found != nullptr) discarded.push_back(found);
+      return join(l1, r1);
+    }
+    // free the (detached) subtrees dropped by a set operation
+    void destroy_discarded(const std::vector<NODE*> &discarded) {
+      for(auto np : discarded) this->destroy_bst(np);
     }
 
 
+    // Whether every node's balance factor is w/in [-1,1] (iterative)
+    bool is_balanced() const {
+      std::vector<const NODE*> stack;
+      if(this->root != nullptr) stack.push_back(this->root);
+      while(!stack.empty()) {
+        const NODE *np = stack.back();
+        stack.pop_back();
+        if(np->left != nullptr)  stack.push_back(np->left);
+        if(np->right != nullptr) stack.push_back(np->right);
+        const long long factor = this->subtree_height(np->left) - this->subtree_height(np->right);
+        if(factor > 1 || factor < -1) return false;
+      }
+      return true;
+    }
+
 
   public:
     // Constructors/Assignment/Destructor 
     avl() = default;
-    avl(const Type e)                        { insert(e); }
+    avl(const Type &e)                       { insert(e); }
+    avl(Type &&e)                            { insert(std::move(e)); }
     avl(const std::initializer_list<Type>&e) { insert(e); }
-    avl(const bst<Type> &tree)               { insert(tree); }
-    avl(const avl &tree)                     { insert(tree); }
-    avl(const std::vector<Type> ordered_vect, int order_type) { 
-      if(order_type != PREORDER && order_type != POSTORDER) {
+    avl(const avl &tree) : bst<Type, Allocator>(tree) {}                 // clones tree's shape
+    avl(avl &&tree) noexcept : bst<Type, Allocator>(std::move(tree)) {}
+    avl(const bst<Type, Allocator> &tree) {                             // balanced bulk build
+      std::vector<Type> elts = tree.inorder_vector();
+      this->build_from_sorted(elts);
+    }
+    avl(const std::vector<Type> &ordered_vect, int order_type) { 
+      if(order_type != PREORDER && order_type != INORDER && order_type != POSTORDER) {
         std::cerr << "\n\033[1m" << __FILE__ << ":" << __func__ << ":" << __LINE__ 
           << ":\033[31mERROR:\033[0m\033[1m namespace::BST::avl CTOR'S ORDERED"
-          << " VECTOR DENOTED NEITHER PRE NOR POST\033[0m\n    –> DEFAULTING TO PRE.\n\n";
+          << " VECTOR DENOTED NEITHER PRE, IN, NOR POST\033[0m\n    –> DEFAULTING TO PRE.\n\n";
         order_type = PREORDER;
       }
-      auto leveled_map = this->sort_ordered_levels(ordered_vect, order_type);
-      for(auto e : leveled_map)
-        insert(e.second);
+      if(order_type == INORDER) {
+        std::vector<Type> elts(ordered_vect);
+        this->sort_unique(elts), this->build_from_sorted(elts);
+        return;
+      }
+      // restore the avl's exact shape if the order describes a balanced tree,
+      // else bulk build a perfectly balanced one from its elts
+      if(this->build_from_order(ordered_vect, order_type) && is_balanced()) return;
+      std::vector<Type> elts(ordered_vect);
+      this->sort_unique(elts), this->build_from_sorted(elts);
+    }
+    template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    avl(InputIt first, InputIt last) {
+      std::vector<Type> elts(first, last);
+      this->sort_unique(elts), this->build_from_sorted(elts);
     }
     virtual ~avl() = default;
     avl &operator=(const avl &tree) {
-      this->destroy_bst(this->root), this->root = nullptr;
-      copy_avl(tree.root);
+      if(this == &tree) return *this;
+      this->destroy_all_nodes(), this->copy_bst(tree.root);
+      return *this;
+    }
+    avl &operator=(avl &&tree) noexcept {
+      bst<Type, Allocator>::operator=(std::move(tree));
+      return *this;
+    }
+    avl &operator=(const bst<Type, Allocator> &tree) {
+      if(this == &tree) return *this;
+      std::vector<Type> elts = tree.inorder_vector();
+      this->build_from_sorted(elts);
+      return *this;
+    }
+
+    // (insertion, removal, emplacement, & iteration are inherited from bst:
+    //  "retrace()" above rebalances the avl after each change)
+    using bst<Type, Allocator>::insert;
+    using bst<Type, Allocator>::remove;
+    void insert(const avl &tree) { union_with(tree); }
+    void remove(const avl &tree) { difference_with(tree); }
+
+
+    // In-Place Set Operations W/ Another avl (join-based: O(m log(n/m + 1)) work
+    // for sizes m <= n, run in parallel on large trees). Union w/ a moved avl takes 
+    // over its nodes, rather than copying them.
+    void union_with(const avl &tree) {
+      if(this == &tree) return;
+      avl tree_copy(tree);
+      union_with(std::move(tree_copy));
+    }
+    void union_with(avl &&tree) {
+      if(this == &tree) return;
+      NODE *tree_root = tree.root;
+      tree.root = nullptr;
+      this->pool.splice(tree.pool);
+      std::vector<NODE*> discarded;
+      this->root = union_nodes(this->root, tree_root, discarded, max_forks());
+      destroy_discarded(discarded);
+    }
+    void intersect_with(const avl &tree) {
+      if(this == &tree) return;
+      std::vector<NODE*> discarded;
+      this->root = filter_nodes(true, this->root, tree.root, discarded, max_forks());
+      destroy_discarded(discarded);
+    }
+    void difference_with(const avl &tree) {
+      if(this == &tree) { this->clear(); return; }
+      std::vector<NODE*> discarded;
+      this->root = filter_nodes(false, this->root, tree.root, discarded, max_forks());
+      destroy_discarded(discarded);
+    }
+  };
+
+
+  // Set Operations Returning A New avl (copying the larger/1st operand, then
+  // combining it in place w/ the other)
+  template <typename Type, template<typename> class Allocator>
+  avl<Type, Allocator> union_of(const avl<Type, Allocator> &a, const avl<Type, Allocator> &b) {
+    avl<Type, Allocator> result((a.size() < b.size()) ? b : a);
+    result.union_with((a.size() < b.size()) ? a : b);
+    return result;
+  }
+  template <typename Type, template<typename> class Allocator>
+  avl<Type, Allocator> intersection_of(const avl<Type, Allocator> &a, const avl<Type, Allocator> &b) {
+    avl<Type, Allocator> result(a);
+    result.intersect_with(b);
+    return result;
+  }
+  template <typename Type, template<typename> class Allocator>
+  avl<Type, Allocator> difference_of(const avl<Type, Allocator> &a, const avl<Type, Allocator> &b) {
+    avl<Type, Allocator> result(a);
+    result.difference_with(b);
+    return result;
+  }
+
+
+  // Persistent avl: every insertion/removal copies only the root-to-leaf path it
+  // changes (O(log n) new nodes) & shares the rest w/ older versions. Each version
+  // is immutable, so readers query a "version" from "snapshot()" w/o ever seeing 
+  // a writer's partial changes, while writers (serialized by a mutex) publish each
+  // new root w/ an atomic store. Nodes are reference counted: a version's unshared 
+  // nodes are freed once its last snapshot is dropped.
+  template <typename Type>
+  class persistent_avl {
+    struct NODE;
+    using node_ptr = std::shared_ptr<const NODE>;
+    struct NODE {
+      Type data; node_ptr left, right;
+      long long height; // # of levels in the subtree rooted here
+      long long nodes;  // # of nodes in the subtree rooted here
+      template<typename Elt>
+      NODE(Elt &&e, node_ptr l, node_ptr r) : data(std::forward<Elt>(e)), left(std::move(l)), right(std::move(r)) {
+        const long long left_height = subtree_height(left), right_height = subtree_height(right);
+        height = 1 + ((left_height > right_height) ? left_height : right_height);
+        nodes  = 1 + subtree_size(left) + subtree_size(right);
+      }
+    };
+    node_ptr root;           // latest published version (only accessed atomically)
+    mutable std::mutex writer;
+
+
+    // Cached Subtree Heights/Sizes (O(1))
+    static long long subtree_height(const node_ptr &np) { return (np == nullptr) ? 0 : np->height; }
+    static long long subtree_size(const node_ptr &np)   { return (np == nullptr) ? 0 : np->nodes;  }
+
+
+    // New Node For 'e' Over Subtrees "left" & "right", Rotating As Needed (the
+    // rotated nodes are new copies: existing nodes are never modified)
+    template<typename Elt>
+    static node_ptr balanced_node(Elt &&e, node_ptr left, node_ptr right) {
+      const long long left_height = subtree_height(left), right_height = subtree_height(right);
+      if(left_height > right_height + 1) {
+        if(subtree_height(left->left) >= subtree_height(left->right))   // LEFT LEFT
+          return std::make_shared<const NODE>(left->data, left->left, 
+                   std::make_shared<const NODE>(std::forward<Elt>(e), left->right, std::move(right)));
+        const node_ptr &pivot = left->right;                              // LEFT RIGHT
+        return std::make_shared<const NODE>(pivot->data, 
+                 std::make_shared<const NODE>(left->data, left->left, pivot->left),
+                 std::make_shared<const NODE>(std::forward<Elt>(e), pivot->right, std::move(right)));
+      }
+      if(right_height > left_height + 1) {
+        if(subtree_height(right->right) >= subtree_height(right->left)) // RIGHT RIGHT
+          return std::make_shared<const NODE>(right->data, 
+                   std::make_shared<const NODE>(std::forward<Elt>(e), std::move(left), right->left), right->right);
+        const node_ptr &pivot = right->left;                              // RIGHT LEFT
+        return std::make_shared<const NODE>(pivot->data, 
+                 std::make_shared<const NODE>(std::forward<Elt>(e), std::move(left), pivot->left),
+                 std::make_shared<const NODE>(right->data, pivot->right, right->right));
+      }
+      return std::make_shared<const NODE>(std::forward<Elt>(e), std::move(left), std::move(right));
+    }
+
+
+    // Copy The Path To 'e'/Its Slot (recursive, O(log n)): returns np itself if unchanged
+    template<typename Elt>
+    static node_ptr insert_path(const node_ptr &np, Elt &&e) {
+      if(np == nullptr) return std::make_shared<const NODE>(std::forward<Elt>(e), nullptr, nullptr);
+      if(e < np->data) {
+        node_ptr left = insert_path(np->left, std::forward<Elt>(e));
+        return (left == np->left) ? np : balanced_node(np->data, std::move(left), np->right);
+      }
+      if(e > np->data) {
+        node_ptr right = insert_path(np->right, std::forward<Elt>(e));
+        return (right == np->right) ? np : balanced_node(np->data, np->left, std::move(right));
+      }
+      return np; // already has 'e'
+    }
+    // copy of subtree "np" w/o its least node (returned in "least")
+    static node_ptr remove_least(const node_ptr &np, node_ptr &least) {
+      if(np->left == nullptr) { least = np; return np->right; }
+      return balanced_node(np->data, remove_least(np->left, least), np->right);
+    }
+    static node_ptr remove_path(const node_ptr &np, const Type &e) {
+      if(np == nullptr) return nullptr;
+      if(e < np->data) {
+        node_ptr left = remove_path(np->left, e);
+        return (left == np->left) ? np : balanced_node(np->data, std::move(left), np->right);
+      }
+      if(e > np->data) {
+        node_ptr right = remove_path(np->right, e);
+        return (right == np->right) ? np : balanced_node(np->data, np->left, std::move(right));
+      }
+      if(np->left == nullptr)  return np->right;
+      if(np->right == nullptr) return np->left;
+      node_ptr least, right = remove_least(np->right, least);
+      return balanced_node(least->data, np->left, std::move(right));
+    }
+    // perfectly balanced subtree of sorted, unique elts [lo,hi) (recursive)
+    static node_ptr build_balanced(std::vector<Type> &elts, const std::size_t lo, const std::size_t hi) {
+      if(lo == hi) return nullptr;
+      const std::size_t mid = lo + (hi - lo) / 2;
+      node_ptr left = build_balanced(elts, lo, mid), right = build_balanced(elts, mid + 1, hi);
+      return std::make_shared<const NODE>(std::move(elts[mid]), std::move(left), std::move(right));
+    }
+
+
+    // Writers Derive The Next Version From The Latest One, Then Publish It
+    template<typename Update>
+    bool publish_update(Update update) {
+      std::lock_guard<std::mutex> lock(writer);
+      node_ptr latest = std::atomic_load(&root), next = update(latest);
+      if(next == latest) return false;
+      std::atomic_store(&root, std::move(next));
+      return true;
+    }
+
+
+
+  public:
+    // Immutable Version Of A persistent_avl (cheap to copy: shares its nodes)
+    class version {
+      friend class persistent_avl;
+      node_ptr root;
+      explicit version(node_ptr version_root) : root(std::move(version_root)) {}
+    public:
+      // Constant Forward Inorder Iterator (w/ a stack of the O(height) nodes above it)
+      class const_iterator {
+        friend class version;
+        std::vector<const NODE*> path;
+        void push_leftmost(const NODE *np) { for(; np != nullptr; np = np->left.get()) path.push_back(np); }
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Type*;
+        using reference         = const Type&;
+
+        const_iterator() = default;
+        reference operator*()  const { return path.back()->data; }
+        pointer   operator->() const { return &path.back()->data; }
+        const_iterator &operator++() {
+          const NODE *np = path.back();
+          path.pop_back();
+          push_leftmost(np->right.get());
+          return *this;
+        }
+        const_iterator operator++(int) { const_iterator it = *this; ++*this; return it; }
+        bool operator==(const const_iterator &it) const { return path == it.path; }
+        bool operator!=(const const_iterator &it) const { return path != it.path; }
+      };
+      using iterator = const_iterator;
+
+      version() = default;
+      const_iterator begin() const { const_iterator it; it.push_leftmost(root.get()); return it; }
+      const_iterator end()   const { return const_iterator(); }
+
+      // Queries (iterative, O(log n))
+      long long size()   const { return subtree_size(root);   }
+      long long height() const { return subtree_height(root); }
+      bool has(const Type &e) const {
+        for(const NODE *np = root.get(); np != nullptr;) {
+          if(e < np->data)      np = np->left.get();
+          else if(e > np->data) np = np->right.get();
+          else return true;
+        }
+        return false;
+      }
+      Type min() const {
+        assert(root != nullptr);
+        const NODE *np = root.get();
+        while(np->left != nullptr) np = np->left.get();
+        return np->data;
+      }
+      Type max() const {
+        assert(root != nullptr);
+        const NODE *np = root.get();
+        while(np->right != nullptr) np = np->right.get();
+        return np->data;
+      }
+      Type select(long long k) const {
+        assert(k >= 0 && k < size());
+        for(const NODE *np = root.get();;) {
+          const long long left_size = subtree_size(np->left);
+          if(k == left_size) return np->data;
+          if(k < left_size) np = np->left.get();
+          else k -= left_size + 1, np = np->right.get();
+        }
+      }
+      long long rank(const Type &e) const {
+        long long elts_less = 0;
+        for(const NODE *np = root.get(); np != nullptr;)
+          if(np->data < e) elts_less += subtree_size(np->left) + 1, np = np->right.get();
+          else np = np->left.get();
+        return elts_less;
+      }
+      std::vector<Type> inorder_vector() const { 
+        std::vector<Type> inord_vect;
+        inord_vect.reserve(size());
+        for(auto it = begin(); it != end(); ++it) inord_vect.push_back(*it);
+        return inord_vect;
+      }
+      void show(const std::string seperator = " ", std::ostream &os = std::cout) const {
+        for(auto it = begin(); it != end(); ++it) os << *it << seperator;
+      }
+      friend std::ostream &operator<<(std::ostream &os, const version &v) { v.show(" ", os); return os; }
+    };
+
+
+    // Constructors/Assignment (copies share the other's latest version in O(1))
+    persistent_avl() = default;
+    persistent_avl(const std::initializer_list<Type>&e) { insert(e); }
+    persistent_avl(const persistent_avl &tree) : root(tree.snapshot().root) {}
+    persistent_avl(const version &v) : root(v.root) {}
+    template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    persistent_avl(InputIt first, InputIt last) { // perfectly balanced bulk build
+      std::vector<Type> elts(first, last);
+      std::sort(elts.begin(), elts.end());
+      elts.erase(std::unique(elts.begin(), elts.end()), elts.end());
+      root = build_balanced(elts, 0, elts.size());
+    }
+    persistent_avl &operator=(const persistent_avl &tree) {
+      if(this != &tree) publish(tree.snapshot());
+      return *this;
+    }
+
+
+    // Atomically Load The Latest Version (O(1)): stays valid & unchanged no matter
+    // what writers do afterwards
+    version snapshot() const { return version(std::atomic_load(&root)); }
+    // Atomically Make "v" The Latest Version (O(1), ie to roll back to a snapshot)
+    void publish(const version &v) {
+      std::lock_guard<std::mutex> lock(writer);
+      std::atomic_store(&root, v.root);
+    }
+
+
+    // Insert/Remove A Particular Elt, Clear (each publishes a new version)
+    bool insert(const Type &e) { return publish_update([&](const node_ptr &np) { return insert_path(np, e); }); }
+    bool insert(Type &&e)      { return publish_update([&](const node_ptr &np) { return insert_path(np, std::move(e)); }); }
+    void insert(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)insert(*it);}
+    bool remove(const Type &e) { return publish_update([&](const node_ptr &np) { return remove_path(np, e); }); }
+    void remove(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)remove(*it);}
+    void clear() { publish(version()); }
+
+
+    // Queries On The Latest Version
+    long long size()         const { return snapshot().size();   }
+    long long height()       const { return snapshot().height(); }
+    bool has(const Type &e)  const { return snapshot().has(e);   }
+    std::vector<Type> inorder_vector() const { return snapshot().inorder_vector(); }
+  };
+
+
+  // Concurrent Ordered Set: "insert()", "remove()", & "has()" may all be called
+  // from any # of threads at once.
+  // => Traversals take no locks (children are atomic pointers & keys never move).
+  //    Writers only lock the node(s) they change, then validate that their 
+  //    optimistic traversal still holds (else they retry from the root).
+  // => Removal is logical 1st ("deleted" flag), then nodes w/ < 2 children are
+  //    unlinked, while others stay as routing nodes until re-inserted or unlinked
+  //    by a later removal passing by.
+  // => Unlinked nodes are freed via epoch-based reclamation once no operation 
+  //    that began before their unlinking is still running.
+  // => "has()" is wait-free: it never locks, retries, or waits on writers.
+  // => Unbalanced (like BST::bst): expected O(log n) depth for keys inserted in 
+  //    random order, but sorted insertions degenerate into a list.
+  template <typename Type>
+  class concurrent_bst {
+    // Per-Node Lock: a 1-byte spin lock (rather than a 40-byte std::mutex) keeps 
+    // a node's children & data on 1 cache line for readers. Critical sections 
+    // are a handful of loads & stores, so waiters just yield.
+    class spin_lock {
+      std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    public:
+      void lock() { while(flag.test_and_set(std::memory_order_acquire)) std::this_thread::yield(); }
+      void unlock() { flag.clear(std::memory_order_release); }
+    };
+    // Nodes & The Head (whose right child is the root): all links are locked by 
+    // their owner's mutex, & multiple locks are always taken parent 1st
+    struct link_owner {
+      std::atomic<link_owner*> child[2]; // left, right (always NODEs)
+      std::atomic<bool> removed;         // unlinked from the tree
+      spin_lock lock;
+      link_owner() : removed(false) { child[0] = nullptr, child[1] = nullptr; }
+    };
+    struct NODE : link_owner {
+      const Type data;
+      std::atomic<bool> deleted; // logically removed from the set
+      template<typename... Args> explicit NODE(Args&&... args) : data(std::forward<Args>(args)...), deleted(false) {}
+    };
+    static NODE *child_of(const link_owner *owner, const int dir) { 
+      return static_cast<NODE*>(owner->child[dir].load()); 
+    }
+    link_owner head;
+    std::atomic<long long> elts{0};
+
+
+    // Epoch-Based Reclamation: each operation counts itself as active in the parity
+    // of the global epoch it read on entry (spread over cache-line-aligned stripes to
+    // avoid contention), w/o ever retrying. The epoch only advances once no ops are
+    // counted in the previous epoch's parity, so by the time it moves past E+2, 
+    // every op that could've reached a node retired in epoch E has finished.
+    // (Heap-allocated trees only get aligned stripes from C++17's aligned "new".)
+    static const int stripes = 64;
+    struct alignas(64) stripe { 
+      std::atomic<long long> active[2]; 
+      stripe() { active[0] = 0, active[1] = 0; }
+    };
+    mutable stripe counters[stripes];
+    mutable std::atomic<unsigned long long> epoch{2};
+    std::mutex retire_lock;
+    std::vector<std::pair<unsigned long long, NODE*>> retired; // (retirement epoch, node)
+
+    static int thread_stripe() {
+      static std::atomic<unsigned> threads_seen(0);
+      static thread_local const int thread_index = threads_seen++ % stripes;
+      return thread_index;
+    }
+    class epoch_guard {
+      std::atomic<long long> &counter;
+    public:
+      explicit epoch_guard(const concurrent_bst &tree) 
+        : counter(tree.counters[thread_stripe()].active[tree.epoch.load() & 1]) { counter.fetch_add(1); }
+      ~epoch_guard() { counter.fetch_sub(1); }
+    };
+    // queue an unlinked node for freeing, & occasionally try to advance the epoch
+    void retire(NODE *np) {
+      std::lock_guard<std::mutex> lock(retire_lock);
+      retired.emplace_back(epoch.load(), np);
+      if(retired.size() % 64 == 0) try_reclaim();
+    }
+    void try_reclaim() {
+      const unsigned long long current = epoch.load();
+      for(int i = 0; i < stripes; ++i)
+        if(counters[i].active[(current + 1) & 1].load() != 0) return; // ops from "current - 1" still run
+      epoch.store(current + 1);
+      std::size_t kept = 0;
+      for(std::size_t i = 0; i < retired.size(); ++i) {
+        if(retired[i].first + 2 <= current) delete retired[i].second;
+        else retired[kept++] = retired[i];
+      }
+      retired.resize(kept);
+    }
+
+
+    // Find 'e' (lock-free): returns its node or nullptr, w/ "parent"/"dir" set to 
+    // the link that holds it (or where it would be inserted). If "tidy", also 
+    // tries to unlink the deleted nodes w/ < 2 children that it passes.
+    NODE *find(const Type &e, link_owner *&parent, int &dir, const bool tidy = false) {
+      parent = &head, dir = 1;
+      for(NODE *np = child_of(parent, dir); np != nullptr; np = child_of(parent, dir)) {
+        if(tidy && np->deleted && (child_of(np, 0) == nullptr || child_of(np, 1) == nullptr) 
+                && try_unlink(parent, dir, np)) {
+          retire(np);
+          continue; // re-read the same link
+        }
+        if(e < np->data)      parent = np, dir = 0;
+        else if(e > np->data) parent = np, dir = 1;
+        else return np;
+      }
+      return nullptr;
+    }
+    // unlink a deleted node w/ < 2 children from "parent" (if still valid, else
+    // leaves it for later): returns whether it was unlinked
+    bool try_unlink(link_owner *parent, const int dir, NODE *np) {
+      std::lock_guard<spin_lock> parent_lock(parent->lock);
+      std::lock_guard<spin_lock> np_lock(np->lock);
+      if(parent->removed || child_of(parent, dir) != np || np->removed || !np->deleted) return false;
+      NODE *left = child_of(np, 0), *right = child_of(np, 1);
+      if(left != nullptr && right != nullptr) return false;
+      np->removed = true;
+      parent->child[dir].store((left != nullptr) ? left : right);
+      return true;
+    }
+    // insert 'e' (if "e" is nullptr, its node is made from "args" 1st to compare w/), 
+    // otherwise only making its node from "args" once 'e' is found absent
+    template<typename... Args>
+    bool insert_elt(const Type *e, Args&&... args) {
+      epoch_guard guard(*this);
+      NODE *new_node = (e == nullptr) ? new NODE(std::forward<Args>(args)...) : nullptr;
+      for(;;) {
+        link_owner *parent;
+        int dir;
+        NODE *np = find((new_node != nullptr) ? new_node->data : *e, parent, dir);
+        if(np != nullptr) { // revive a deleted node (unless unlinked meanwhile)
+          std::lock_guard<spin_lock> np_lock(np->lock);
+          if(np->removed) continue;
+          delete new_node;
+          if(!np->deleted) return false;
+          np->deleted = false, ++elts;
+          return true;
+        }
+        if(new_node == nullptr) new_node = new NODE(std::forward<Args>(args)...);
+        std::lock_guard<spin_lock> parent_lock(parent->lock);
+        if(parent->removed || child_of(parent, dir) != nullptr) continue; // changed under us
+        parent->child[dir].store(new_node), ++elts;
+        return true;
+      }
+    }
+
+
+  public:
+    concurrent_bst() = default;
+    concurrent_bst(const std::initializer_list<Type>&e) { for(auto it = e.begin(); it != e.end(); ++it) insert(*it); }
+    concurrent_bst(const concurrent_bst &) = delete;
+    concurrent_bst &operator=(const concurrent_bst &) = delete;
+    // (no other operations may run during destruction)
+    ~concurrent_bst() {
+      std::vector<NODE*> stack;
+      if(child_of(&head, 1) != nullptr) stack.push_back(child_of(&head, 1));
+      while(!stack.empty()) {
+        NODE *np = stack.back();
+        stack.pop_back();
+        if(child_of(np, 0) != nullptr) stack.push_back(child_of(np, 0));
+        if(child_of(np, 1) != nullptr) stack.push_back(child_of(np, 1));
+        delete np;
+      }
+      for(auto &retiree : retired) delete retiree.second;
+    }
+
+
+    // Insert/Remove A Particular Elt (return whether the set changed)
+    bool insert(const Type &e) { return insert_elt(&e, e); }
+    bool insert(Type &&e)      { return insert_elt(&e, std::move(e)); }
+    template<typename... Args>
+    bool emplace(Args&&... args) { return insert_elt(nullptr, std::forward<Args>(args)...); }
+    bool remove(const Type &e) {
+      epoch_guard guard(*this);
+      for(;;) {
+        link_owner *parent;
+        int dir;
+        NODE *np = find(e, parent, dir, true);
+        if(np == nullptr) return false;
+        {
+          std::lock_guard<spin_lock> np_lock(np->lock);
+          if(np->removed) continue; // unlinked meanwhile: 'e' may since have been re-inserted
+          if(np->deleted) return false;
+          np->deleted = true, --elts;
+        }
+        if(try_unlink(parent, dir, np)) retire(np);
+        return true;
+      }
+    }
+
+
+    // Check Whether The Set Contains 'e' (wait-free)
+    bool has(const Type &e) const {
+      epoch_guard guard(*this);
+      for(const NODE *np = child_of(&head, 1); np != nullptr;) {
+        if(e < np->data)      np = child_of(np, 0);
+        else if(e > np->data) np = child_of(np, 1);
+        else return !np->deleted;
+      }
+      return false;
+    }
+
+
+    // # Of Elts (exact when no writers are running)
+    long long size() const { return elts.load(); }
+    // Inorder Elts (each elt is present at some point during the call, if not all at once)
+    std::vector<Type> inorder_vector() const {
+      epoch_guard guard(*this);
+      std::vector<Type> inord_vect;
+      std::vector<const NODE*> path;
+      for(const NODE *np = child_of(&head, 1); np != nullptr || !path.empty();) {
+        for(; np != nullptr; np = child_of(np, 0)) path.push_back(np);
+        np = path.back(), path.pop_back();
+        if(!np->deleted) inord_vect.push_back(np->data);
+        np = child_of(np, 1);
+      }
+      return inord_vect;
+    }
+  };
+
+
+  // Cache-Friendly Ordered Set: a B-tree w/ up to "B" sorted elts per node (by
+  // default as many as fill a 64-byte cache line, but at least 4), thus each 
+  // search visits O(log_B n) nodes rather than a bst's O(log2 n).
+  // => Same public interface as BST::bst & BST::avl, minus their binary-node-only
+  //    methods (pre/postorder, order statistics, & "show_diagram()").
+  // => Arithmetic elts are found w/in a node by counting its keys less than 'e'
+  //    across all B slots (unused slots hold +inf or the type's max): a fixed-length,
+  //    branchless loop that compilers vectorize into SIMD compares. Other types 
+  //    binary search each node's keys.
+  // => Iterators are (node, slot) pairs, found via parent links. Since insertions
+  //    & removals move elts between nodes, both invalidate every iterator.
+  // => "Type" must also be default-constructible (for unused key slots).
+  template <typename Type, int B = (sizeof(Type) <= 16) ? static_cast<int>(64 / sizeof(Type)) : 4,
+            template<typename> class Allocator = node_pool>
+  class btree {
+    static_assert(B >= 3, "BST::btree NODES MUST HOLD AT LEAST 3 ELTS");
+    static const int min_elts = (B - 1) / 2; // # of elts non-root nodes are refilled to after removals
+    static const bool padded = std::is_arithmetic<Type>::value;
+
+    // value of unused key slots: no arithmetic elt is greater (+inf for floating points)
+    static Type padding() {
+      return std::numeric_limits<Type>::has_infinity ? std::numeric_limits<Type>::infinity() : std::numeric_limits<Type>::max();
+    }
+
+
+    // btree Node Struct (leaves have no children), Root, # Of Elts, & Node Allocator
+    struct NODE {
+      int n = 0;          // # of elts in use
+      Type keys[B];       // sorted elts (unused slots hold "padding()", if arithmetic)
+      NODE *child[B + 1]; // child[i] holds the elts between keys[i-1] & keys[i]
+      NODE *parent = nullptr;
+      NODE() {
+        std::fill(child, child + B + 1, nullptr);
+        if(padded) std::fill(keys, keys + B, padding());
+      }
+      bool is_leaf() const { return child[0] == nullptr; }
+    };
+    NODE *root = nullptr;
+    long long elts = 0;
+    Allocator<NODE> pool;
+
+
+    // Private Methods
+    // alloc/free a node
+    NODE *mknode(NODE *parent) {
+      NODE *np = pool.allocate();
+      try {
+        new (np) NODE();
+      } catch(...) {
+        pool.deallocate(np);
+        throw;
+      }
+      np->parent = parent;
+      return np;
+    }
+    void freenode(NODE *np) {
+      np->~NODE();
+      pool.deallocate(np);
+    }
+    // frees every node (iterative): pools of trivially destructible data release 
+    // their slabs outright, rather than visiting each node
+    void destroy_all_nodes() {
+      if(!Allocator<NODE>::bulk_release || !std::is_trivially_destructible<Type>::value) {
+        std::vector<NODE*> pending;
+        if(root != nullptr) pending.push_back(root);
+        while(!pending.empty()) {
+          NODE *np = pending.back();
+          pending.pop_back();
+          if(!np->is_leaf()) pending.insert(pending.end(), np->child, np->child + np->n + 1);
+          freenode(np);
+        }
+      }
+      pool.release(), root = nullptr, elts = 0;
+    }
+    // clone another btree's exact shape into this empty one (iterative)
+    void copy_btree(const NODE *src, const long long src_elts) {
+      if(src == nullptr) return;
+      std::vector<std::pair<const NODE*, NODE*>> pending(1, {src, root = mknode(nullptr)});
+      while(!pending.empty()) {
+        const NODE *from = pending.back().first;
+        NODE *np = pending.back().second;
+        pending.pop_back();
+        std::copy(from->keys, from->keys + from->n, np->keys), np->n = from->n;
+        if(!from->is_leaf())
+          for(int i = 0; i <= from->n; ++i) pending.push_back({from->child[i], np->child[i] = mknode(np)});
+      }
+      elts = src_elts;
+    }
+
+
+    // Bulk Building (O(n)): a subtree of "height" levels from sorted, unique elts
+    // [lo,hi) (moved from), spreading each level's elts evenly across its nodes
+    // ("capacity[h-1]" is the most elts a subtree of height h can hold)
+    NODE *build(std::vector<Type> &elts_vect, std::size_t lo, const std::size_t hi, 
+                const std::vector<std::size_t> &capacity, const std::size_t height, NODE *parent) {
+      NODE *np = mknode(parent);
+      if(height == 1) {
+        std::move(elts_vect.begin() + lo, elts_vect.begin() + hi, np->keys);
+        np->n = static_cast<int>(hi - lo);
+        return np;
+      }
+      const std::size_t count = hi - lo, below = capacity[height - 2];
+      const std::size_t children = std::max<std::size_t>(2, (count + below + 1) / (below + 1));
+      const std::size_t per_child = (count - children + 1) / children, extra = (count - children + 1) % children;
+      for(std::size_t i = 0; i < children; ++i) {
+        const std::size_t child_elts = per_child + (i < extra);
+        np->child[i] = build(elts_vect, lo, lo + child_elts, capacity, height - 1, np);
+        lo += child_elts;
+        if(i + 1 < children) np->keys[i] = std::move(elts_vect[lo++]);
+      }
+      np->n = static_cast<int>(children - 1);
+      return np;
+    }
+    // replace the btree w/ 1 of the least height holding sorted, unique "elts_vect"
+    void build_from_sorted(std::vector<Type> &elts_vect) {
+      destroy_all_nodes();
+      if(elts_vect.empty()) return;
+      std::vector<std::size_t> capacity(1, B);
+      while(capacity.back() < elts_vect.size()) capacity.push_back(capacity.back() * (B + 1) + B);
+      root = build(elts_vect, 0, elts_vect.size(), capacity, capacity.size(), nullptr);
+      elts = static_cast<long long>(elts_vect.size());
+    }
+
+
+    // # of elts in "np" less than 'e' (ie the slot of 'e', else of the child that'd hold it)
+    static int rank_in_node(const NODE *np, const Type &e) {
+      if(padded) {
+        int elts_less = 0;
+        for(int i = 0; i < B; ++i) elts_less += (np->keys[i] < e);
+        return (elts_less < np->n) ? elts_less : np->n; // (in case 'e' beats the padding itself)
+      }
+      return static_cast<int>(std::lower_bound(np->keys, np->keys + np->n, e) - np->keys);
+    }
+    // node & slot holding 'e' (nullptr if DNE), w/ the node's level in "level"
+    NODE *find(const Type &e, int &slot, long long &level) const {
+      level = 0;
+      for(NODE *np = root; np != nullptr; np = np->child[slot], ++level) {
+        slot = rank_in_node(np, e);
+        if(slot < np->n && !(e < np->keys[slot])) return np;
+      }
+      return nullptr;
+    }
+    // nearest slots to 'e' (iterative, O(log n)): the least slot above 'e' (or at
+    // it, if "inclusive") & the greatest slot below 'e' (or at it), else nullptr 
+    // (w/ "bound_slot" 0, as in "end()")
+    NODE *least_above(const Type &e, const bool inclusive, int &bound_slot) const {
+      NODE *bound = nullptr;
+      bound_slot = 0;
+      for(NODE *np = root; np != nullptr;) {
+        int slot = rank_in_node(np, e);
+        if(slot < np->n && !(e < np->keys[slot])) { // found 'e'
+          if(inclusive) { bound_slot = slot; return np; }
+          ++slot;
+        }
+        if(slot < np->n) bound = np, bound_slot = slot;
+        np = np->child[slot];
+      }
+      return bound;
+    }
+    NODE *greatest_below(const Type &e, const bool inclusive, int &bound_slot) const {
+      NODE *bound = nullptr;
+      bound_slot = 0;
+      for(NODE *np = root; np != nullptr;) {
+        const int slot = rank_in_node(np, e);
+        if(inclusive && slot < np->n && !(e < np->keys[slot])) { bound_slot = slot; return np; }
+        if(slot > 0) bound = np, bound_slot = slot - 1;
+        np = np->child[slot];
+      }
+      return bound;
+    }
+    // slot of "child" in its parent's children
+    static int slot_of(const NODE *parent, const NODE *child) {
+      int slot = 0;
+      while(parent->child[slot] != child) ++slot;
+      return slot;
+    }
+    static NODE *leftmost_leaf(NODE *np) {
+      if(np != nullptr) while(!np->is_leaf()) np = np->child[0];
+      return np;
+    }
+    static NODE *rightmost_leaf(NODE *np) {
+      if(np != nullptr) while(!np->is_leaf()) np = np->child[np->n];
+      return np;
+    }
+    static void repad(NODE *np) {
+      if(padded) std::fill(np->keys + np->n, np->keys + B, padding());
+    }
+
+
+    // put 'e' at "slot" of a non-full node, w/ "kid" as the child on its right
+    // ("side" = 1) or left ("side" = 0)
+    static void place(NODE *np, const int slot, Type &&e, NODE *kid, const int side = 1) {
+      std::move_backward(np->keys + slot, np->keys + np->n, np->keys + np->n + 1);
+      std::copy_backward(np->child + slot + side, np->child + np->n + 1, np->child + np->n + 2);
+      np->keys[slot] = std::move(e), np->child[slot + side] = kid;
+      if(kid != nullptr) kid->parent = np;
+      ++np->n;
+    }
+    // take the elt out of "slot", along w/ the child on its right/left (per "side")
+    static Type take(NODE *np, const int slot, const int side = 1) {
+      Type e = std::move(np->keys[slot]);
+      std::move(np->keys + slot + 1, np->keys + np->n, np->keys + slot);
+      std::copy(np->child + slot + side + 1, np->child + np->n + 1, np->child + slot + side);
+      np->child[np->n--] = nullptr;
+      repad(np);
+      return e;
+    }
+
+
+    // Insertion: put 'e' at "slot" of "np" (a leaf, unless "right" is the subtree
+    // split off to its right). Full nodes split around their middle elt, which 
+    // then moves up into their parent in turn (iterative, up to a new root).
+    void insert_at(NODE *np, int slot, Type e, NODE *right) {
+      for(;;) {
+        if(np->n < B) {
+          place(np, slot, std::move(e), right);
+          return;
+        }
+        const int mid = B / 2;
+        NODE *sibling = mknode(np->parent);
+        sibling->n = B - mid - 1;
+        std::move(np->keys + mid + 1, np->keys + B, sibling->keys);
+        std::copy(np->child + mid + 1, np->child + B + 1, sibling->child);
+        std::fill(np->child + mid + 1, np->child + B + 1, nullptr);
+        if(!sibling->is_leaf()) for(int i = 0; i <= sibling->n; ++i) sibling->child[i]->parent = sibling;
+        Type middle = std::move(np->keys[mid]);
+        np->n = mid, repad(np);
+        if(slot <= mid) place(np, slot, std::move(e), right);
+        else            place(sibling, slot - mid - 1, std::move(e), right);
+        if(np->parent == nullptr) {
+          root = mknode(nullptr);
+          root->keys[0] = std::move(middle), root->n = 1;
+          root->child[0] = np, root->child[1] = sibling;
+          np->parent = sibling->parent = root;
+          return;
+        }
+        slot = slot_of(np->parent, np), np = np->parent;
+        e = std::move(middle), right = sibling;
+      }
+    }
+    // insert 'e' into its leaf (returns whether it was inserted, ie not already present)
+    template<typename Elt>
+    bool insert_elt(Elt &&e) {
+      if(root == nullptr) {
+        root = mknode(nullptr);
+        root->keys[0] = std::forward<Elt>(e), root->n = 1, elts = 1;
+        return true;
+      }
+      NODE *np = root;
+      int slot;
+      for(;;) {
+        slot = rank_in_node(np, e);
+        if(slot < np->n && !(e < np->keys[slot])) return false;
+        if(np->is_leaf()) break;
+        np = np->child[slot];
+      }
+      insert_at(np, slot, Type(std::forward<Elt>(e)), nullptr);
+      ++elts;
+      return true;
+    }
+
+
+    // Removal: refill a node left w/ too few elts by borrowing 1 from a sibling
+    // (through their parent), else merge it w/ a sibling, taking 1 elt from 
+    // their parent (which may then need refilling in turn)
+    void merge_children(NODE *parent, const int slot) { // child[slot+1] into child[slot]
+      NODE *left = parent->child[slot], *right = parent->child[slot + 1];
+      left->keys[left->n] = take(parent, slot);
+      std::move(right->keys, right->keys + right->n, left->keys + left->n + 1);
+      std::copy(right->child, right->child + right->n + 1, left->child + left->n + 1);
+      if(!right->is_leaf()) for(int i = 0; i <= right->n; ++i) right->child[i]->parent = left;
+      left->n += right->n + 1;
+      freenode(right);
+    }
+    void refill(NODE *np) {
+      while(np != root && np->n < min_elts) {
+        NODE *parent = np->parent;
+        const int slot = slot_of(parent, np);
+        NODE *left  = (slot > 0)         ? parent->child[slot - 1] : nullptr;
+        NODE *right = (slot < parent->n) ? parent->child[slot + 1] : nullptr;
+        if(left != nullptr && left->n > min_elts) {        // rotate right
+          NODE *moved = left->child[left->n];
+          Type e = take(left, left->n - 1);
+          place(np, 0, std::move(parent->keys[slot - 1]), moved, 0);
+          parent->keys[slot - 1] = std::move(e);
+          return;
+        }
+        if(right != nullptr && right->n > min_elts) {      // rotate left
+          NODE *moved = right->child[0];
+          Type e = take(right, 0, 0);
+          place(np, np->n, std::move(parent->keys[slot]), moved);
+          parent->keys[slot] = std::move(e);
+          return;
+        }
+        merge_children(parent, (left != nullptr) ? slot - 1 : slot);
+        np = parent;
+      }
+      if(root->n == 0) { // emptied root: its only child (if any) takes over
+        NODE *old_root = root;
+        root = root->child[0];
+        if(root != nullptr) root->parent = nullptr;
+        freenode(old_root);
+      }
+    }
+
+
+  public:
+    // Constructors/Assignment/Destructor
+    btree() = default;
+    btree(const Type &e) { insert(e); }
+    btree(Type &&e)      { insert(std::move(e)); }
+    btree(const btree &tree) { copy_btree(tree.root, tree.elts); }
+    btree(btree &&tree) noexcept : root(tree.root), elts(tree.elts), pool(std::move(tree.pool)) { 
+      tree.root = nullptr, tree.elts = 0; 
+    }
+    btree(const std::initializer_list<Type>&e) { insert(e); }
+    // Bulk builds a btree of the least height from any range of elts (sorted or 
+    // not) in O(n) (plus an O(n log n) sort if unsorted)
+    template<typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    btree(InputIt first, InputIt last) {
+      std::vector<Type> elts_vect(first, last);
+      if(!std::is_sorted(elts_vect.begin(), elts_vect.end())) std::sort(elts_vect.begin(), elts_vect.end());
+      elts_vect.erase(std::unique(elts_vect.begin(), elts_vect.end()), elts_vect.end());
+      build_from_sorted(elts_vect);
+    }
+    ~btree() { destroy_all_nodes(); }
+    btree &operator=(const btree &tree) {
+      if(this == &tree) return *this;
+      destroy_all_nodes(), copy_btree(tree.root, tree.elts);
       return *this;
     }
-    avl &operator=(const bst<Type> &tree) {
-      avl avl_tree(tree); 
-      *this = avl_tree; 
+    btree &operator=(btree &&tree) noexcept {
+      if(this == &tree) return *this;
+      destroy_all_nodes();
+      root = tree.root, elts = tree.elts, tree.root = nullptr, tree.elts = 0;
+      pool = std::move(tree.pool);
       return *this;
     }
 
-    // Insert/Remove A Particular Elt, Clear Entire avl
-    void insert(const Type e) { this->root = addnode(this->root, e); }
+
+    // Bidirectional Inorder Iterator Over The btree's Slots (Constant, Like std::set's)
+    class const_iterator {
+      friend class btree;
+      NODE *np = nullptr;
+      int slot = 0;
+      const btree *tree = nullptr; // to step back from "end()"
+      const_iterator(NODE *node, const int node_slot, const btree *owner) : np(node), slot(node_slot), tree(owner) {}
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = Type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const Type*;
+      using reference         = const Type&;
+
+      const_iterator() = default;
+      reference operator*()  const { return np->keys[slot]; }
+      pointer   operator->() const { return &np->keys[slot]; }
+      const_iterator &operator++() {
+        if(!np->is_leaf()) {
+          np = leftmost_leaf(np->child[slot + 1]), slot = 0;
+          return *this;
+        }
+        ++slot;
+        while(slot == np->n) { // climb past the last slot of each subtree
+          if(np->parent == nullptr) { np = nullptr, slot = 0; break; }
+          slot = slot_of(np->parent, np), np = np->parent;
+        }
+        return *this;
+      }
+      const_iterator &operator--() {
+        if(np == nullptr) {
+          np = rightmost_leaf(tree->root), slot = np->n - 1;
+          return *this;
+        }
+        if(!np->is_leaf()) {
+          np = rightmost_leaf(np->child[slot]), slot = np->n - 1;
+          return *this;
+        }
+        while(slot == 0) slot = slot_of(np->parent, np), np = np->parent;
+        --slot;
+        return *this;
+      }
+      const_iterator operator++(int) { const_iterator it = *this; ++*this; return it; }
+      const_iterator operator--(int) { const_iterator it = *this; --*this; return it; }
+      bool operator==(const const_iterator &it) const { return np == it.np && slot == it.slot; }
+      bool operator!=(const const_iterator &it) const { return !(*this == it); }
+    };
+    using iterator               = const_iterator;
+    using reverse_iterator       = std::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Inorder Iterators
+    iterator               begin()   const {return iterator(leftmost_leaf(root), 0, this);}
+    iterator               end()     const {return iterator(nullptr, 0, this);}
+    const_iterator         cbegin()  const {return begin();}
+    const_iterator         cend()    const {return end();}
+    reverse_iterator       rbegin()  const {return reverse_iterator(end());}
+    reverse_iterator       rend()    const {return reverse_iterator(begin());}
+    const_reverse_iterator crbegin() const {return rbegin();}
+    const_reverse_iterator crend()   const {return rend();}
+
+
+    // Insert/Remove A Particular Elt, Clear Entire btree
+    void insert(const Type &e) { insert_elt(e); }
+    void insert(Type &&e)      { insert_elt(std::move(e)); }
     void insert(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)insert(*it);}
-    void insert(const bst<Type> &tree){for(auto it=tree.begin();it!=tree.end();++it)insert(*it);}
-    void insert(const avl &tree){copy_avl(tree.root);}
-    bool remove(const Type e){bool found=false; this->root = rmnode(this->root,e,found); if(found)this->data_set.erase(e); return found;}
+    void insert(const btree &tree){for(auto it=tree.begin();it!=tree.end();++it)insert(*it);}
+    bool remove(const Type &e) {
+      int slot;
+      long long level;
+      NODE *np = find(e, slot, level);
+      if(np == nullptr) return false;
+      if(np->is_leaf()) {
+        take(np, slot);
+      } else { // overwrite 'e' w/ its predecessor, taken from the end of a leaf
+        NODE *leaf = rightmost_leaf(np->child[slot]);
+        np->keys[slot] = take(leaf, leaf->n - 1);
+        np = leaf;
+      }
+      --elts;
+      refill(np);
+      return true;
+    }
     void remove(const std::initializer_list<Type>&e){for(auto it=e.begin();it!=e.end();++it)remove(*it);}
-    void remove(const bst<Type> &tree){for(auto it=tree.begin();it!=tree.end();++it)remove(*it);}
-    void remove(const avl &tree){for(auto it=tree.begin();it!=tree.end();++it)remove(*it);}
+    void remove(const btree &tree){for(auto it=tree.begin();it!=tree.end();++it)remove(*it);}
+    void clear() { destroy_all_nodes(); }
 
-    // Remove Data Satisfying A Particular Condition
+
+    // Construct An Elt From "args" & Insert It (returns whether it was inserted)
+    template<typename... Args>
+    bool emplace(Args&&... args) { return insert_elt(Type(std::forward<Args>(args)...)); }
+
+
+    // Remove Data Satisfying A Particular Condition (in 1 inorder pass, then an
+    // O(n) bulk rebuild from the elts kept)
     template<typename Unary_Predicate>
     void remove_if(Unary_Predicate condition) {
-      for(auto it = this->data_set.begin(); it != this->data_set.end();)
-        (condition(*it)) ? (remove(*it), this->data_set.erase(*it), it=this->data_set.begin()) : ++it;
+      std::vector<Type> kept;
+      kept.reserve(elts);
+      for(auto it = begin(); it != end(); ++it)
+        if(!condition(*it)) kept.push_back(*it);
+      if(static_cast<long long>(kept.size()) != elts) build_from_sorted(kept);
+    }
+
+
+    // Return Inorder Elt Vector
+    std::vector<Type> inorder_vector() const {
+      std::vector<Type> inord_vect;
+      inord_vect.reserve(elts);
+      for(auto it = begin(); it != end(); ++it)
+        inord_vect.push_back(*it);
+      return inord_vect;
+    }
+    // Immutable, Contiguous Eytzinger-Layout Copy For Fast Read-Only Lookups
+    frozen<Type> freeze() const { return frozen<Type>(inorder_vector()); }
+
+
+    // Min/Max Values In btree (first/last elts of its leftmost/rightmost leaves)
+    Type min() const {
+      assert(root != nullptr);
+      return leftmost_leaf(root)->keys[0];
+    }
+    Type max() const {
+      assert(root != nullptr);
+      const NODE *np = rightmost_leaf(root);
+      return np->keys[np->n - 1];
+    }
+
+
+    // Check Whether btree Contains Given 'e' Data (iterative)
+    bool has(const Type &e) const { return (level_of(e) != -1); }
+
+
+    // Nearest Elts To 'e' (iterative, O(log n)): "end()" if there's none
+    const_iterator lower_bound(const Type &e) const { int slot; NODE *np = least_above(e, true, slot);     return const_iterator(np, slot, this); } // least >= e
+    const_iterator upper_bound(const Type &e) const { int slot; NODE *np = least_above(e, false, slot);    return const_iterator(np, slot, this); } // least > e
+    const_iterator ceil(const Type &e)        const { return lower_bound(e); }                                                                  // least >= e
+    const_iterator floor(const Type &e)       const { int slot; NODE *np = greatest_below(e, true, slot);  return const_iterator(np, slot, this); } // greatest <= e
+    const_iterator successor(const Type &e)   const { return upper_bound(e); }                                                                  // least > e
+    const_iterator predecessor(const Type &e) const { int slot; NODE *np = greatest_below(e, false, slot); return const_iterator(np, slot, this); } // greatest < e
+
+
+    // Range Of The Elts In [lo,hi), In Order (lazy & w/o copying: O(log n + k) to
+    // visit its k elts). Stays valid until an elt is inserted/removed, or its btree
+    // is cleared/destroyed.
+    class elt_range {
+      friend class btree;
+      const_iterator first, last;
+      elt_range(const const_iterator &lo_it, const const_iterator &hi_it) : first(lo_it), last(hi_it) {}
+    public:
+      const_iterator begin() const { return first; }
+      const_iterator end()   const { return last;  }
+    };
+    elt_range range(const Type &lo, const Type &hi) const {
+      const const_iterator last = lower_bound(hi);
+      return elt_range((lo < hi) ? lower_bound(lo) : last, last);
+    }
+
+
+    // Count Elts/Height/Level-Of-Elt Of btree
+    long long size()   const { return elts; } // O(1), cached count
+    long long sizeO1() const { return elts; } // (same as "size()")
+    long long height() const {                // O(log_B n): all leaves share 1 level
+      long long levels = 0;
+      for(const NODE *np = root; np != nullptr; np = np->child[0]) ++levels;
+      return levels;
+    }
+    long long level_of(const Type &e) const { // level of the node holding 'e', -1 if DNE
+      int slot;
+      long long level;
+      return (find(e, slot, level) != nullptr) ? level : -1;
+    }
+
+
+    // Output Each Elt In btree
+    void show_inorder(const std::string seperator = " ", std::ostream &os = std::cout) const {
+      for(auto it = begin(); it != end(); ++it) os << *it << seperator;
+    }
+    void show(const std::string seperator = " ", std::ostream &os = std::cout) const {
+      show_inorder(seperator, os);
+    }
+
+
+    // Overloaded I/O Stream Friends
+    friend std::ostream &operator<<(std::ostream &os, const btree &tree) { tree.show(" ", os); return os; }
+    friend std::istream &operator>>(std::istream &is, btree &tree) { 
+      Type e; is >> e; is.get(); tree.insert(e); return is; 
+    }
+  };
+
+
+  // Frozen Read-Only Ordered Set: sorted elts laid out in Eytzinger (BFS) order
+  // in 1 contiguous array, ie the implicit perfectly balanced bst whose node k has
+  // children 2k & 2k+1 (k = 1 is the root), made by "freeze()" on a bst/avl/btree.
+  // => Searches descend w/o branching on comparisons (k = 2k + (elt < e)), & 
+  //    prefetch the cache line holding node k's descendants a few levels down.
+  // => Batched lookups descend several queries level-by-level in lockstep, so
+  //    their cache misses overlap rather than happen one after another.
+  // => Copies share the same (immutable) array, thus any # of threads may search
+  //    a frozen set at once.
+  // => "Type" must also be default-constructible.
+  template <typename Type>
+  class frozen {
+    // queries descended in lockstep by batched lookups
+    static const std::size_t batch_size = 16;
+    // elts per cache line (if a power of 2): a search at node k prefetches node
+    // k * line_elts, the 1st of its line_elts descendants log2(line_elts) levels
+    // further down, which all share 1 cache line (as the array is aligned)
+    static const std::size_t line_elts = (64 % sizeof(Type) == 0) ? 64 / sizeof(Type) : 1;
+
+    std::shared_ptr<const std::vector<Type>> storage;
+    const Type *eytz = nullptr; // eytz[k] is node k (eytz[0] is unused)
+    std::size_t n = 0;
+    std::size_t full_levels = 0; // # of levels w/ all their nodes
+
+
+    // Eytzinger Index Arithmetic
+    // inorder first/last/next node (0 once past the last)
+    std::size_t first_node() const {
+      std::size_t k = (n == 0) ? 0 : 1;
+      while(k != 0 && 2 * k <= n) k *= 2;
+      return k;
+    }
+    std::size_t last_node() const {
+      std::size_t k = (n == 0) ? 0 : 1;
+      while(k != 0 && 2 * k + 1 <= n) k = 2 * k + 1;
+      return k;
+    }
+    std::size_t next_node(std::size_t k) const {
+      if(2 * k + 1 > n) return unwind(k);
+      for(k = 2 * k + 1; 2 * k <= n; k *= 2);
+      return k;
+    }
+    // climb back past a descent's trailing right turns, then past its last left 
+    // turn: the node that left turn came from (ie the least elt >= the query), 
+    // or 0 if the descent never turned left
+    static std::size_t unwind(const std::size_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+      return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+      std::size_t node = k;
+      while(node & 1) node >>= 1;
+      return node >> 1;
+#endif
+    }
+    void prefetch(const std::size_t k) const {
+#if defined(__GNUC__) || defined(__clang__)
+      if(line_elts > 1) __builtin_prefetch(eytz + std::min(k * line_elts, n));
+#else
+      (void)k;
+#endif
+    }
+    // 1 branchless step down from node k toward 'e' (for k <= n)
+    std::size_t descend(const std::size_t k, const Type &e) const {
+      prefetch(k);
+      return 2 * k + (eytz[k] < e);
+    }
+
+
+    // Build "eytz" From Sorted, Unique Elts (moved from): filling nodes in inorder
+    // leaves each elt at its node in the implicit bst
+    void build(std::vector<Type> &sorted) {
+      n = sorted.size();
+      for(full_levels = 0; (std::size_t(2) << full_levels) - 1 <= n; ++full_levels);
+      // over-allocate by a cache line, to start "eytz" on a cache line boundary
+      std::shared_ptr<std::vector<Type>> slots = std::make_shared<std::vector<Type>>(n + 1 + line_elts);
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(slots->data());
+      const std::size_t offset = (line_elts > 1 && address % sizeof(Type) == 0) ? (64 - address % 64) % 64 / sizeof(Type) : 0;
+      Type *nodes = slots->data() + offset;
+      std::size_t next = 0;
+      eytz = nodes;
+      for(std::size_t k = first_node(); k != 0; k = next_node(k)) nodes[k] = std::move(sorted[next++]);
+      storage = std::move(slots);
+    }
+
+
+  public:
+    // Constructors (elts need not be sorted or unique: "freeze()" passes inorder ones)
+    frozen() = default;
+    explicit frozen(std::vector<Type> elts) {
+      bool strictly_ascending = true;
+      for(std::size_t i = 1; i < elts.size() && strictly_ascending; ++i)
+        strictly_ascending = elts[i-1] < elts[i];
+      if(!strictly_ascending) {
+        std::sort(elts.begin(), elts.end());
+        elts.erase(std::unique(elts.begin(), elts.end()), elts.end());
+      }
+      build(elts);
+    }
+
+
+    // Node Index Of The Least Elt >= 'e' (0 if none): all full levels are
+    // descended unconditionally, then at most 1 step into the partial last level
+    std::size_t lower_bound_node(const Type &e) const {
+      std::size_t k = 1;
+      for(std::size_t level = 0; level < full_levels; ++level) k = descend(k, e);
+      if(k <= n) k = descend(k, e);
+      return unwind(k);
+    }
+
+
+    // Least Elt >= 'e' (nullptr if none) & Whether The Set Contains 'e'
+    const Type *lower_bound(const Type &e) const {
+      const std::size_t k = lower_bound_node(e);
+      return (k == 0) ? nullptr : eytz + k;
+    }
+    bool has(const Type &e) const {
+      const std::size_t k = lower_bound_node(e);
+      return k != 0 && !(e < eytz[k]);
+    }
+
+
+    // Batched Lookups: results[i] is for queries[i] (each batch of queries 
+    // descends 1 level at a time together, overlapping their cache misses)
+    std::vector<const Type*> lower_bound(const std::vector<Type> &queries) const {
+      std::vector<const Type*> results(queries.size(), nullptr);
+      for(std::size_t first = 0; first < queries.size(); first += batch_size) {
+        const std::size_t count = (queries.size() - first < batch_size) ? queries.size() - first : batch_size;
+        const Type *batch = queries.data() + first;
+        std::size_t k[batch_size];
+        std::fill(k, k + count, std::size_t(1));
+        for(std::size_t level = 0; level < full_levels; ++level)
+          for(std::size_t i = 0; i < count; ++i) k[i] = descend(k[i], batch[i]);
+        for(std::size_t i = 0; i < count; ++i) {
+          if(k[i] <= n) k[i] = descend(k[i], batch[i]);
+          k[i] = unwind(k[i]);
+          if(k[i] != 0) results[first + i] = eytz + k[i];
+        }
+      }
+      return results;
+    }
+    std::vector<bool> has(const std::vector<Type> &queries) const {
+      const std::vector<const Type*> bounds = lower_bound(queries);
+      std::vector<bool> found(queries.size());
+      for(std::size_t i = 0; i < queries.size(); ++i)
+        found[i] = bounds[i] != nullptr && !(queries[i] < *bounds[i]);
+      return found;
+    }
+
+
+    // Size, Min/Max, & Inorder Elts
+    long long size() const { return static_cast<long long>(n); }
+    Type min() const {
+      assert(n != 0);
+      return eytz[first_node()];
+    }
+    Type max() const {
+      assert(n != 0);
+      return eytz[last_node()];
+    }
+    std::vector<Type> inorder_vector() const {
+      std::vector<Type> inord_vect;
+      inord_vect.reserve(n);
+      for(std::size_t k = first_node(); k != 0; k = next_node(k)) inord_vect.push_back(eytz[k]);
+      return inord_vect;
+    }
+
+
+    // Output Each Elt (inorder)
+    void show(const std::string seperator = " ", std::ostream &os = std::cout) const {
+      for(std::size_t k = first_node(); k != 0; k = next_node(k)) os << eytz[k] << seperator;
     }
+    friend std::ostream &operator<<(std::ostream &os, const frozen &set) { set.show(" ", os); return os; }
   };
 }
 #endif
@@ -0,0 +1,96 @@
+// Author: Jordan Randleman -- BST_ConcurrentBench.cpp -- BST::concurrent_bst Scalability Benchmark
+
+// Measures throughput (operations/second) of BST::concurrent_bst against a
+// BST::avl guarded by 1 global std::mutex, for 1..64 threads at several
+// read/write ratios. Writes are split evenly between insertions & removals of
+// uniformly random keys, so the set stays ~half full of its key range.
+//
+// BUILD: g++ -std=c++11 -O2 -pthread BST_ConcurrentBench.cpp -o BST_ConcurrentBench
+// RUN:   ./BST_ConcurrentBench [seconds_per_run = 0.5] [key_range = 1000000]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "BST.hpp"
+
+/******************************************************************************
+* SETS UNDER TEST (SAME insert/remove/has INTERFACE)
+******************************************************************************/
+
+// BST::avl serialized by a global mutex (the baseline)
+class locked_avl {
+  BST::avl<long long> tree;
+  std::mutex lock;
+public:
+  void insert(const long long e) { std::lock_guard<std::mutex> guard(lock); tree.insert(e); }
+  void remove(const long long e) { std::lock_guard<std::mutex> guard(lock); tree.remove(e); }
+  bool has(const long long e)    { std::lock_guard<std::mutex> guard(lock); return tree.has(e); }
+};
+
+/******************************************************************************
+* BENCHMARK DRIVER
+******************************************************************************/
+
+// run "threads" workers for "seconds" on a set prefilled w/ half of "key_range",
+// returning total operations/second
+template <typename Set>
+double throughput(const int threads, const int read_percent, const double seconds, const long long key_range) {
+  Set set;
+  std::mt19937_64 prefill_rng(12345);
+  for(long long i = 0; i < key_range / 2; ++i) set.insert(prefill_rng() % key_range);
+
+  std::atomic<bool> start(false), stop(false);
+  std::atomic<long long> total_ops(0);
+  std::vector<std::thread> workers;
+  for(int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]{
+      std::mt19937_64 rng(t + 1);
+      long long ops = 0;
+      while(!start.load()) std::this_thread::yield();
+      while(!stop.load(std::memory_order_relaxed)) {
+        for(int i = 0; i < 64; ++i, ++ops) { // check the clock flag every 64 ops
+          const unsigned long long draw = rng();
+          const long long key = static_cast<long long>((draw >> 8) % key_range);
+          const int roll = static_cast<int>(draw & 0xffff) % 100;
+          if(roll < read_percent)                       set.has(key);
+          else if((roll - read_percent) % 2 == 0)       set.insert(key);
+          else                                          set.remove(key);
+        }
+      }
+      total_ops += ops;
+    });
+  }
+  const auto begin = std::chrono::steady_clock::now();
+  start = true;
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  stop = true;
+  for(auto &worker : workers) worker.join();
+  const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  return total_ops.load() / elapsed;
+}
+
+
+int main(int argc, char *argv[]) {
+  const double seconds     = (argc > 1) ? std::atof(argv[1]) : 0.5;
+  const long long key_range = (argc > 2) ? std::atoll(argv[2]) : 1000000;
+  const int read_percents[] = {50, 90, 99};
+  const int thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+  std::printf("BST::concurrent_bst vs mutex-guarded BST::avl: %g s/run, keys in [0, %lld), %u hardware threads\n",
+              seconds, key_range, std::thread::hardware_concurrency());
+  for(const int read_percent : read_percents) {
+    std::printf("\n%d%% has(), %d%% insert(), %d%% remove()\n", read_percent, (100 - read_percent + 1) / 2, (100 - read_percent) / 2);
+    std::printf("%8s %18s %18s %9s\n", "threads", "concurrent ops/s", "locked ops/s", "speedup");
+    for(const int threads : thread_counts) {
+      const double concurrent = throughput<BST::concurrent_bst<long long>>(threads, read_percent, seconds, key_range);
+      const double locked     = throughput<locked_avl>(threads, read_percent, seconds, key_range);
+      std::printf("%8d %18.0f %18.0f %8.2fx\n", threads, concurrent, locked, concurrent / locked);
+    }
+  }
+  return 0;
+}
@@ -4,24 +4,60 @@
 #include <random> // for std::default_random_engine
 #include <chrono> // for std::chrono::system_clock
 #include <vector>
+#include <thread> // for std::thread
+#include <limits> // for std::numeric_limits
 #include "BST.hpp"
 
 
 /***
  * bst & avl Current Available Methods (suppose "Type elt;"):
  * (00) bst()/avl(), bst(elt)/avl(elt), bst(bst)/avl(bst), bst(intializer_list)/avl(intializer_list),
- *      bst(vector, BST::PREORDER [OR BST::POSTORDER])/avl(vector, BST::PREORDER [OR BST::POSTORDER]),
- *      ~bst()/~avl()
- * (01) insert(elt), insert(intializer_list), insert(bst/avl)
+ *      bst(vector, BST::PREORDER [OR BST::INORDER OR BST::POSTORDER])/avl(vector, ...),
+ *      bst(first_iterator, last_iterator)/avl(first_iterator, last_iterator), ~bst()/~avl()
+ * (01) insert(elt), insert(intializer_list), insert(bst/avl), emplace(args...)
  * (02) remove(elt), remove(intializer_list), remove(bst/avl), remove_if(Unary_Predicate_function)
  * (03) clear()
- * (04) preorder_vector(), postorder_vector(), inorder_vector()
+ * (04) preorder_vector(), postorder_vector(), inorder_vector(), freeze()
  * (05) min(), max()
  * (06) has(elt)
  * (07) size(), sizeO1(), height(), level_of(elt)
  * (08) show(), show_preorder(), show_inorder(), show_postorder()
  * (09) show_diagram()
  * (10) begin(), cbegin(), crbegin(), rbegin(), end(), cend(), crend(), rend()
+ * (11) select(k), rank(elt), count_range(lo_elt, hi_elt)
+ * (12) preorder(), inorder(), postorder(), levelorder()
+ * (13) avl only: union_with(avl), intersect_with(avl), difference_with(avl),
+ *      & BST::union_of(avl, avl), BST::intersection_of(avl, avl), BST::difference_of(avl, avl)
+ * (14) lower_bound(elt), upper_bound(elt), floor(elt), ceil(elt), predecessor(elt), successor(elt),
+ *      range(lo_elt, hi_elt)
+ *
+ * BST::persistent_avl<Type> (path-copying versions, published atomically):
+ * (00) persistent_avl(), persistent_avl(intializer_list), persistent_avl(persistent_avl),
+ *      persistent_avl(version), persistent_avl(first_iterator, last_iterator)
+ * (01) snapshot(), publish(version)
+ * (02) insert(elt), remove(elt), clear()
+ * (03) size(), height(), has(elt), inorder_vector()
+ * (04) version: begin(), end(), size(), height(), has(elt), min(), max(), select(k), rank(elt),
+ *      inorder_vector(), show()
+ *
+ * BST::concurrent_bst<Type> (unbalanced, lock-free reads, per-node locks for writes):
+ * (00) concurrent_bst(), concurrent_bst(intializer_list)
+ * (01) insert(elt), emplace(args...), remove(elt)
+ * (02) has(elt), size(), inorder_vector()
+ *
+ * BST::btree<Type, B> (B-tree w/ up to B sorted elts per node, default: 1 cache line's worth):
+ * (00) btree(), btree(elt), btree(btree), btree(intializer_list), btree(first_iterator, last_iterator)
+ * (01) insert(elt), insert(intializer_list), insert(btree), emplace(args...)
+ * (02) remove(elt), remove(intializer_list), remove(btree), remove_if(Unary_Predicate_function), clear()
+ * (03) inorder_vector(), freeze(), min(), max(), has(elt), size(), sizeO1(), height(), level_of(elt)
+ * (04) show(), show_inorder(), begin(), cbegin(), crbegin(), rbegin(), end(), cend(), crend(), rend()
+ * (05) lower_bound(elt), upper_bound(elt), floor(elt), ceil(elt), predecessor(elt), successor(elt),
+ *      range(lo_elt, hi_elt)
+ *
+ * BST::frozen<Type> (read-only Eytzinger-layout array, made by "freeze()" on a bst/avl/btree):
+ * (00) frozen(), frozen(vector)
+ * (01) has(elt), lower_bound(elt), & batched: has(vector), lower_bound(vector)
+ * (02) size(), min(), max(), inorder_vector(), show()
  *
  * NOTES:
  *   => BST::bst && BST::avl => BOTH HAVE THE SAME PUBLIC INTERFACE!
@@ -132,6 +168,16 @@ int main() {
     cout << *it << ", ";
   cout << endl;
 
+  // traversal ranges lazily visit elts in pre/in/post/level order w/o recursion,
+  // so loops may stop early
+  cout << "\nAVL's 1st 5 elts \"levelorder\": ";
+  int levelorder_count = 0;
+  for(auto &elt : avl_tree.levelorder()) {
+    if(levelorder_count++ == 5) break;
+    cout << elt << ", ";
+  }
+  cout << endl;
+
 
 
   // Constructing a BST from a std::vector of AVL preorder elts
@@ -146,6 +192,60 @@ int main() {
   cout << "\nBST::avl ctor'd via std::vector of AVL's \"postorder\" elts:";
   postord_ctord_avl.show_diagram();
 
+  // nearest-elt searches & lazy [lo,hi) ranges (no copying)
+  cout << "\nBST::avl's elts in [20,60): ";
+  for(auto elt : avl_tree.range(20, 60)) cout << elt << ' ';
+  auto next_elt = avl_tree.successor(20);
+  if(next_elt != avl_tree.end()) cout << "(successor of 20: " << *next_elt << ")";
+  cout << endl;
+
+  // avl set operations split & join trees (in parallel for large ones)
+  BST::avl<int> evens_avl{0, 2, 4, 6, 8, 10}, small_avl{0, 1, 2, 3, 4, 5};
+  cout << "\nunion, intersection, & difference of {0,2,4,6,8,10} & {0,1,2,3,4,5}:\n"
+       << BST::union_of(evens_avl, small_avl) << endl
+       << BST::intersection_of(evens_avl, small_avl) << endl
+       << BST::difference_of(evens_avl, small_avl) << endl;
+
+
+  // persistent avl snapshots stay unchanged (& safe to read from other threads)
+  // while later versions are published
+  BST::persistent_avl<int> persistent_tree{3, 1, 4, 1, 5};
+  auto old_version = persistent_tree.snapshot();
+  persistent_tree.insert(9), persistent_tree.remove(1);
+  cout << "\npersistent_avl's old snapshot: " << old_version 
+       << "\npersistent_avl's latest version: " << persistent_tree.snapshot() << endl;
+
+
+  // concurrent bst: insert/remove/has may all run from many threads at once
+  BST::concurrent_bst<int> concurrent_tree;
+  std::vector<std::thread> inserters;
+  for(int t = 0; t < 4; ++t)
+    inserters.emplace_back([&concurrent_tree, t]{ for(int i = t; i < 20; i += 4) concurrent_tree.insert(i); });
+  for(auto &inserter : inserters) inserter.join();
+  concurrent_tree.remove(0);
+  cout << "\nconcurrent_bst filled w/ 0-19 by 4 threads, then w/o 0: ";
+  for(auto elt : concurrent_tree.inorder_vector()) cout << elt << ' ';
+  cout << endl;
+
+
+  // btrees pack many sorted elts into each node (here 4), for fewer cache misses
+  BST::btree<int, 4> btree_tree{8, 3, 10, 1, 6, 14, 4, 7, 13};
+  btree_tree.remove(6);
+  cout << "\nbtree w/o 6: " << btree_tree << "(height " << btree_tree.height() 
+       << ", min " << btree_tree.min() << ", max " << btree_tree.max() << ")" << endl;
+
+  // arithmetic btree elts may even be the type's extremes (ie +inf & DBL_MAX)
+  BST::btree<double> extremes_btree{1.0, std::numeric_limits<double>::infinity(), 2.0, 
+                                    std::numeric_limits<double>::max(), -std::numeric_limits<double>::infinity()};
+  cout << "btree of doubles w/ +/-inf & DBL_MAX: " << extremes_btree << endl;
+
+
+  // frozen read-only copies search a flat Eytzinger-ordered array w/o branching
+  BST::frozen<int> frozen_tree = btree_tree.freeze();
+  std::vector<bool> frozen_found = frozen_tree.has(std::vector<int>{4, 5, 13});
+  cout << "\nfrozen btree: " << frozen_tree << "(least elt >= 11: " << *frozen_tree.lower_bound(11)
+       << ", has 4/5/13: " << frozen_found[0] << frozen_found[1] << frozen_found[2] << ")" << endl;
+
 
   cout << endl << "Bye!\n\n";
 
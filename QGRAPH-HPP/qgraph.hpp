@@ -8,6 +8,30 @@
 #define QGRAPH_HPP_
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <memory>
+#include <string>
+#include <thread>
+// "binary_reader" memory-maps files on POSIX systems (unless compiled w/
+// "-DQGRAPH_NO_MMAP"), else reads them into memory via std::ifstream
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(QGRAPH_NO_MMAP)
+#define QGRAPH_USE_MMAP
+#endif
+#ifdef QGRAPH_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /*
  * OPERATING DEFINITION:
@@ -46,20 +70,26 @@
 /* 
  * PUBLIC CONTENTS:
  *
- * TYPE ALIASES (4):
+ * TYPE ALIASES (8):
  *   (0) qnum         // NUMERIC (ie any point, total # of points, etc)
  *   (1) qnums        // NUMERIC VECTOR (ie coordinates, list of adjacent points, etc)
  *   (2) qnum_matrix  // NUMERIC VECTOR MATRIX (ie inner cubes, list of adjacent coords, etc)
  *   (3) coord_matrix // NUMERIC VECTOR 3D MATRIX (ie coord adjacency matrix, inner cubes in coords, etc)
+ *   (4) subcube      // COMPACT INNER CUBE (free-dimension bitmask & base point)
+ *   (5) subcubes     // COMPACT INNER CUBE VECTOR
+ *   (6) qedge        // EDGE AS (LOWER POINT, HIGHER POINT)
+ *   (7) qedges       // EDGE VECTOR
  *
  *
- * NON MEMBER FUNCTIONS (3):
+ * NON MEMBER FUNCTIONS (5):
  *   (0) qnum        convert_coord_to_point(qnums)  // converts coords to a point
  *   (1) qnums       shortest_path(qnum, qnum)      // returns shortest path btwn given pts
  *   (2) qnum_matrix shortest_path(qnums, qnums)    // returns shortest path's coords btwn given coords
+ *   (3) qnum        shortest_path(qnum, qnum, OutputIt)   // writes shortest path btwn given pts, returns its length
+ *   (4) qnum        shortest_path(qnums, qnums, OutputIt) // writes shortest path's flattened coords, returns its length
  * 
  *
- * MEMBERS OF Hypercube (19): 
+ * MEMBERS OF Hypercube (41): 
  *   (00) qnum dimension                            // member dictating Hypercube's dimension
  *   (01) qnum total_points()                       // returns total points in 'dimension'
  * 
@@ -83,9 +113,155 @@
  *   (16) qnum_matrix  inner_cubes(Hypercube)       // given Hypercube of dimension n, returns matrix of all n cubes' pts in 'dimension'
  *   (17) coord_matrix inner_cubes_coord(qnum)      // given dimension n, returns matrix of all n cubes' pt-coords in 'dimension'
  *   (18) coord_matrix inner_cubes_coord(Hypercube) // given Hypercube of dimension n, returns matrix of all n cubes' pt-coords in 'dimension'
+ *
+ *   (19) qnums    subcube_points(subcube)          // returns sorted points composing the given subcube
+ *   (20) subcubes largest_inner_cubes_within(qnums) // returns all greatest-dimension subcubes lying fully w/in the given points
+ *   (21) subcubes maximal_inner_cubes_within(qnums) // returns all subcubes w/in the given points not w/in a larger one
+ *
+ *   (22) qnum       total_edges()                  // returns total edges in 'dimension' (N * 2^(N-1))
+ *   (23) qnum       edge_rank(qnum, qnum)          // returns O(1) rank of the edge btwn 2 adjacent pts
+ *   (24) qnum       edge_rank(qedge)               // returns O(1) rank of the given edge
+ *   (25) qedge      edge_unrank(qnum)              // returns the edge w/ the given rank in O(1)
+ *   (26) edge_range lazy_edges()                   // returns lazy sequence of all edges in rank order
+ *   (27) edge_range lazy_dimension_edges(qnum)     // returns lazy sequence of the edges along the given dimension
+ *   (28) qedges     edges()                        // returns vector of all edges in rank order
+ *   (29) qedges     dimension_edges(qnum)          // returns vector of the edges along the given dimension
+ *
+ *   (30) qnum convert_point_to_coord(qnum, OutputIt) // writes point's coords, returns # written
+ *   (31) qnum adjacent_points(qnum, OutputIt)        // writes sorted pts adjacent to given pt, returns # written
+ *   (32) qnum adjacent_coords(qnum, OutputIt)        // writes flattened coords of adjacent pts, returns # of pts
+ *
+ *   (33) qnum    sample_stride()                   // # of rng counters each sample consumes (dimension + 1)
+ *   (34) qnum    random_point(counter_rng)         // returns a uniformly random point
+ *   (35) subcube random_subcube(qnum, counter_rng) // returns a uniformly random n-cube
+ *   (36) qnum    random_shortest_path(qnum, qnum, counter_rng, OutputIt) // writes a uniformly random shortest path
+ *   (37) qnums   random_shortest_path(qnum, qnum, counter_rng)           // returns a uniformly random shortest path
+ *   (38) qnum    random_points(qnum, counter_rng, OutputIt)              // writes a batch of random points
+ *   (39) qnum    random_subcubes(qnum, qnum, counter_rng, OutputIt)      // writes a batch of random n-cubes
+ *   (40) qnum    random_shortest_paths(qnum, qnum, qnum, counter_rng, OutputIt) // writes a batch of random shortest paths
+ *
+ *
+ * EDGE-INDEXED TYPES (2):
+ *   (0) edge_range                                 // lazy random-access sequence of edges over a rank range
+ *   (1) edge_array<T>                              // dense array of T's indexed by edge rank or by (point, point)
+ *
+ *
+ * BINARY STREAMING EXPORT (7):
+ *   (0) binary_kinds                               // EDGE_LIST, CSR_ADJACENCY, or SUBCUBE_LIST
+ *   (1) binary_writer                              // streams varint/delta-coded records to a file in chunks
+ *   (2) binary_reader                              // memory-maps a written file & walks its records in place
+ *   (3) bool write_edge_list(Hypercube, path)      // streams all edges in rank order
+ *   (4) bool write_adjacency_csr(Hypercube, path)  // streams all points' adjacency lists
+ *   (5) bool write_inner_cubes(Hypercube, qnum, path)  // streams all n-cubes w/o materializing them
+ *   (6) bool write_subcubes(subcubes, qnum, path)  // streams the given subcubes
+ *
+ *
+ * RANDOM-FAILURE SIMULATION (4):
+ *   (0) counter_rng                                // counter-based RNG: each draw is a pure fcn of (seed,stream,counter)
+ *   (1) failure_modes                              // VERTEX_FAILURES, EDGE_FAILURES, or VERTEX_AND_EDGE_FAILURES
+ *   (2) percolation_sample                         // one (p,trial) result: giant-component fraction & component-size histogram
+ *   (3) Percolation                                // multithreaded percolation sweeps over failure probabilities p
+ *
+ *
+ * SHARED QUERY RESULT CACHE (3) --- OPT-IN, THREAD-SAFE, LRU BOUNDED BY BYTES:
+ *   (0) query_cache                                // memoizes adjacency matrices, n-cubes & counts by dimension
+ *   (1) query_cache_stats                          // hits, misses, evictions, entries & bytes in use
+ *   (2) query_cache &shared_query_cache()          // process-wide cache instance
+ *
+ *
+ * MESH, RING, & TREE EMBEDDINGS (10):
+ *   (0) qedges mesh_edges(qnums)                   // guest mesh edges (nodes row-major) for the given axis sizes
+ *   (1) qedges ring_edges(qnum)                    // guest ring edges
+ *   (2) qedges tree_edges(qnum)                    // guest complete binary tree edges (nodes in heap order)
+ *   (3) qedges double_rooted_tree_edges(qnum)      // guest double-rooted tree edges (2nd root indexed last)
+ *   (4) qnums  gray_code_mesh_embedding(Hypercube, qnums)  // dilation-1 mesh embedding via per-axis gray codes
+ *   (5) qnums  ring_embedding(Hypercube, qnum)     // ring embedding: a Hamiltonian cycle at length 2^N
+ *   (6) qnums  inorder_tree_embedding(Hypercube, qnum)       // dilation-2 tree embedding via inorder labels
+ *   (7) qnums  double_rooted_tree_embedding(Hypercube, qnum) // dilation-1 spanning double-rooted tree
+ *   (8) embedding_metrics                          // load, expansion, dilation & congestion of an embedding
+ *   (9) embedding_metrics evaluate_embedding(Hypercube, qnums, qedges) // parallel evaluation of any embedding
+ *
+ *
+ * INDUCED SUBGRAPH DISTANCES (2):
+ *   (0) induced_subgraph                           // point-subset bitmap w/ direction-optimizing BFS, eccentricity, & 
+ *                                                  //   64-source bit-parallel all-pairs distances
+ *   (1) distance_distribution                      // all-pairs distance histogram, eccentricities, diameter, etc.
+ *
+ *
+ * OPT-IN INSTRUMENTATION (2) --- COMPILE W/ "-DQGRAPH_INSTRUMENT", ELSE ALL COUNTERS STAY 0 & COST NOTHING:
+ *   (0) inner_cubes_stats                          // per-phase ns timings & hot-path counters of one "inner_cubes" call
+ *   (1) last_inner_cubes_stats()                   // the calling thread's stats from its latest "inner_cubes" call
  */
 
 
+/******************************************************************************
+* OPT-IN "inner_cubes" INSTRUMENTATION: COMPILE W/ "-DQGRAPH_INSTRUMENT"
+******************************************************************************/
+
+namespace qgraph {
+  // Counters for the calling thread's latest "inner_cubes" call (timings in ns)
+  struct inner_cubes_stats {
+    unsigned long long total_ns = 0;
+    unsigned long long adjacency_matrix_ns = 0;     // "point_adjacency_matrix"
+    unsigned long long combinations_ns = 0;         // "get_n_combinations_in_range"
+    unsigned long long register_points_ns = 0;      // "register_and_derive_shared_point_adjacency_lists"
+    unsigned long long erase_seen_points_ns = 0;    // "erase_seen_points"
+    unsigned long long derive_shared_points_ns = 0; // "derive_shared_cube_points"
+    unsigned long long erase_seen_point_P_ns = 0;   // "erase_seen_point_P_from_adjMatrix"
+    unsigned long long candidate_combinations = 0;  // point combinations tried as n-cube seeds
+    unsigned long long rejected_combinations = 0;   // candidates that didn't seed an n-cube
+    unsigned long long cubes_found = 0;             // candidates that did (incl. duplicates)
+    unsigned long long sorted_inserts = 0, sorted_erases = 0, sorted_finds = 0;
+    unsigned long long vector_reallocations = 0;    // capacity growths of the vectors involved
+  };
+
+  namespace instrumentation {
+    inline thread_local inner_cubes_stats current;
+    inline thread_local bool active = false; // only "inner_cubes" calls are counted
+
+    // Resets "current" & turns counting on for the scope of 1 "inner_cubes" call
+    struct call_scope {
+      const bool was_active = active;
+      call_scope() { current = inner_cubes_stats{}, active = true; }
+      ~call_scope() { active = was_active; }
+    };
+
+    // Adds the wall time of its scope to "field" (if begun w/in "inner_cubes")
+    struct phase_timer {
+      unsigned long long *const ns;
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      explicit phase_timer(unsigned long long &field) : ns(active ? &field : nullptr) {}
+      ~phase_timer() { 
+        if(ns) *ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(); 
+      }
+    };
+  }
+
+  // Returns the calling thread's counters from its latest "inner_cubes" call
+  // (always all 0 unless compiled w/ QGRAPH_INSTRUMENT defined)
+  inline const inner_cubes_stats &last_inner_cubes_stats() { return instrumentation::current; }
+}
+
+// Without QGRAPH_INSTRUMENT these expand to nothing, so cost nothing. With it,
+// the shared helpers below only count while an "inner_cubes" call is running.
+#ifdef QGRAPH_INSTRUMENT
+  #define QGRAPH_CALL_SCOPE() qgraph::instrumentation::call_scope qgraph_call_scope_
+  #define QGRAPH_COUNT(field, n) \
+    (qgraph::instrumentation::active ? void(qgraph::instrumentation::current.field += (n)) : void())
+  #define QGRAPH_TIME_PHASE(field) qgraph::instrumentation::phase_timer qgraph_phase_timer_(qgraph::instrumentation::current.field)
+  #define QGRAPH_TRACK_GROWTH(v, expr) do { \
+    const auto qgraph_capacity_ = (v).capacity(); expr; \
+    if(qgraph::instrumentation::active && (v).capacity() != qgraph_capacity_) \
+      ++qgraph::instrumentation::current.vector_reallocations; \
+  } while(0)
+#else
+  #define QGRAPH_CALL_SCOPE() ((void)0)
+  #define QGRAPH_COUNT(field, n) ((void)0)
+  #define QGRAPH_TIME_PHASE(field) ((void)0)
+  #define QGRAPH_TRACK_GROWTH(v, expr) expr
+#endif
+
+
 /******************************************************************************
 * PRIVATE COMPUTATIONAL HELPER FUNCTIONS --- USERS DISREGARD
 ******************************************************************************/
@@ -101,14 +277,16 @@ template<typename T>
 static void sorted_insert(std::vector<T>&v, const T elt) {
   // "lower_bound" performs binary search
   auto position = std::lower_bound(v.begin(), v.end(), elt);
+  QGRAPH_COUNT(sorted_inserts, 1);
   if(position == v.end() || elt < *position)
-    v.insert(position, elt);
+    QGRAPH_TRACK_GROWTH(v, v.insert(position, elt));
 }
 
 template<typename T>
 static void sorted_erase(std::vector<T>&v, const T elt) {
   // "lower_bound" performs binary search
   auto position = std::lower_bound(v.begin(), v.end(), elt);
+  QGRAPH_COUNT(sorted_erases, 1);
   if(position != v.end() && *position == elt)
     v.erase(position);
 }
@@ -117,6 +295,7 @@ template<typename T>
 static bool sorted_find(const std::vector<T>&v, const T elt) {
   // "lower_bound" performs binary search
   auto position = std::lower_bound(v.begin(), v.end(), elt);
+  QGRAPH_COUNT(sorted_finds, 1);
   return (position != v.end() && *position == elt);
 }
 
@@ -154,6 +333,50 @@ std::vector<unsigned long long>&b) {
 }
 
 
+// Removes bit "d" from "x" (shifting the higher bits down 1) & its inverse,
+// inserting a 0 bit at position "d" (shifting the higher bits up 1)
+static unsigned long long remove_bit(const unsigned long long x, const unsigned long long d) {
+  return ((x >> (d + 1)) << d) | (x & ((1ULL << d) - 1));
+}
+static unsigned long long insert_zero_bit(const unsigned long long x, const unsigned long long d) {
+  return ((x >> d) << (d + 1)) | (x & ((1ULL << d) - 1));
+}
+
+
+// High 64 bits of the 128-bit product a * b: a native 128-bit multiply where the
+// compiler has 1 (ie GCC & Clang on 64-bit targets), else 4 32x32->64 partials
+static unsigned long long mulhi(const unsigned long long a, const unsigned long long b) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128; // "__extension__" keeps -Wpedantic quiet
+  return (unsigned long long)((uint128(a) * b) >> 64);
+#else
+  const unsigned long long a_lo = a & 0xffffffffULL, a_hi = a >> 32, b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+  const unsigned long long lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+  const unsigned long long cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi; // <= 2^64 - 1
+  return hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+
+// Splits [0,n) into "threads" contiguous ranges & invokes fn(lo,hi,thread_idx) on each
+// in parallel (the calling thread runs the last range itself)
+template<typename Fcn>
+static void parallel_for_ranges(const unsigned long long n, unsigned long long threads, Fcn fn) {
+  if(!threads) threads = 1;
+  if(threads > n) threads = n ? n : 1;
+  std::vector<std::thread> workers;
+  const unsigned long long chunk = n / threads, extra = n % threads;
+  unsigned long long lo = 0;
+  for(unsigned long long t = 0; t < threads; ++t) {
+    const unsigned long long hi = lo + chunk + (t < extra);
+    if(t + 1 == threads) fn(lo, hi, t);
+    else workers.emplace_back(fn, lo, hi, t);
+    lo = hi;
+  }
+  for(auto &worker : workers) worker.join();
+}
+
+
 /******************************************************************************
 * PUBLIC "qgraph" NAMESPACE FOR "HYPERCUBE" STRUCT & TO PERFORM COMPUTATIONS
 ******************************************************************************/
@@ -170,6 +393,70 @@ namespace qgraph {
   using qnum_matrix = std::vector<qnums>;
   using coord_matrix = std::vector<qnum_matrix>;
 
+  // Compact n-cube: every point matching "base" outside of "free_mask"
+  // (n = # of bits set in "free_mask", & base's bits w/in "free_mask" are 0)
+  struct subcube { qnum free_mask = 0, base = 0; };
+  using subcubes = std::vector<subcube>;
+
+  // Edge between 2 adjacent points, always stored as (lower point, higher point)
+  using qedge  = std::pair<qnum,qnum>;
+  using qedges = std::vector<qedge>;
+
+  /******************************************************************************
+  * LAZY EDGE SEQUENCES
+  ******************************************************************************/
+
+  // Edges are ranked dimension-major: the 2^(N-1) edges along dimension d hold
+  // ranks [d * 2^(N-1), (d+1) * 2^(N-1)), ordered by their lower point. Hence 
+  // rank/unrank are O(1) & a dimension's edges are 1 contiguous slice.
+  struct edge_range {
+    qnum dimension = 0, first = 0, last = 0; // rank range [first,last)
+
+    // Edges are computed on dereference (returned by value), so like the 
+    // iterators of std::views::iota, this only meets the legacy input iterator
+    // requirements, but models C++20's std::random_access_iterator.
+    class iterator {
+      qnum dimension = 0, rank = 0;
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using iterator_concept  = std::random_access_iterator_tag;
+      using value_type        = qedge;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = qedge;
+
+      iterator() = default;
+      iterator(const qnum N, const qnum r) : dimension(N), rank(r) {}
+      qedge operator*() const {
+        const qnum d = rank >> (dimension - 1);
+        const qnum low = insert_zero_bit(rank & ((qnum(1) << (dimension - 1)) - 1), d);
+        return qedge(low, low | (qnum(1) << d));
+      }
+      qedge operator[](const difference_type n) const { return *(*this + n); }
+      iterator &operator++()    { ++rank; return *this; }
+      iterator operator++(int)  { iterator it = *this; ++rank; return it; }
+      iterator &operator--()    { --rank; return *this; }
+      iterator operator--(int)  { iterator it = *this; --rank; return it; }
+      iterator &operator+=(const difference_type n) { rank += n; return *this; }
+      iterator &operator-=(const difference_type n) { rank -= n; return *this; }
+      iterator operator+(const difference_type n) const { return iterator(dimension, rank + n); }
+      iterator operator-(const difference_type n) const { return iterator(dimension, rank - n); }
+      friend iterator operator+(const difference_type n, const iterator &it) { return it + n; }
+      difference_type operator-(const iterator &it) const { return difference_type(rank) - difference_type(it.rank); }
+      bool operator==(const iterator &it) const { return rank == it.rank; }
+      bool operator!=(const iterator &it) const { return rank != it.rank; }
+      bool operator<(const iterator &it)  const { return rank < it.rank;  }
+      bool operator>(const iterator &it)  const { return rank > it.rank;  }
+      bool operator<=(const iterator &it) const { return rank <= it.rank; }
+      bool operator>=(const iterator &it) const { return rank >= it.rank; }
+    };
+
+    iterator begin() const { return iterator(dimension, first); }
+    iterator end()   const { return iterator(dimension, last);  }
+    qnum size()      const { return last - first; }
+    bool empty()     const { return last == first; }
+  };
+
   /******************************************************************************
   * COORDINATE TO POINT CONVERTER (BCD DECODER)
   ******************************************************************************/
@@ -186,24 +473,51 @@ namespace qgraph {
   * SHORTEST DISTANCE BETWEEN 2 POINTS OR 2 COORDINATES
   ******************************************************************************/
 
-  // Returns the shortest path of points from point a to point b.
+  // Writes the shortest path of points from point a to point b to "out" & 
+  // returns the path's length (allocation-free if "out" is).
   // Since adjacent points are labeled s.t. their binary follows gray code, the
   // shortest path is simply found by flipping each bit until the points are =
-  qnums shortest_path(const qnum a, const qnum b) {
-    qnums path;
-    qnum current_point = a;
+  template<typename OutputIt>
+  qnum shortest_path(const qnum a, const qnum b, OutputIt out) {
+    qnum current_point = a, length = 0;
     const qnum gray_code_difference = a ^ b;
-    for(qnum bit = (8*sizeof(qnum))-1; bit >= 0; --bit) {
+    for(qnum bit = 8*sizeof(qnum); bit-- > 0;)
       if((gray_code_difference >> bit) & 1) { // if bits are unequal
-        current_point ^= (1<<bit);            // flip bit
-        path.push_back(current_point);
+        current_point ^= (qnum(1) << bit);    // flip bit
+        *out++ = current_point, ++length;
       }
-      if(!bit) return path;
-    }
+    return length;
+  }
+
+
+  // Returns the shortest path of points from point a to point b.
+  qnums shortest_path(const qnum a, const qnum b) {
+    qnums path;
+    path.reserve(__builtin_popcountll(a ^ b));
+    shortest_path(a, b, std::back_inserter(path));
     return path;
   }
 
 
+  // Writes the shortest path of coordinates from coords a to coords b to "out",
+  // each coord flattened as max(a.size(),b.size()) consecutive values, & returns
+  // the path's length. The shorter coord is treated as prefixed w/ 0's.
+  template<typename OutputIt>
+  qnum shortest_path(const qnums &a, const qnums &b, OutputIt out) {
+    const qnum n = std::max(a.size(), b.size()), a_pad = n - a.size(), b_pad = n - b.size();
+    auto a_at = [&](qnum i) -> qnum { return (i < a_pad) ? 0 : a[i - a_pad]; };
+    auto b_at = [&](qnum i) -> qnum { return (i < b_pad) ? 0 : b[i - b_pad]; };
+    qnum length = 0;
+    for(qnum i = 0; i < n; ++i) {
+      if(a_at(i) == b_at(i)) continue;
+      // coord after flipping entries [0,i] that differ
+      for(qnum j = 0; j < n; ++j) *out++ = (j <= i) ? b_at(j) : a_at(j);
+      ++length;
+    }
+    return length;
+  }
+
+
   // Returns the shortest path of coordinates from coords a to coords b.
   qnum_matrix shortest_path(qnums a, qnums b) {
     if(a.size() != b.size()) prefix_shortest_vector_with_zeros(a,b);
@@ -220,6 +534,60 @@ namespace qgraph {
   }
 
 
+  /******************************************************************************
+  * PRIVATE OUTPUT ITERATOR ADAPTOR --- USERS DISREGARD
+  ******************************************************************************/
+
+  // Output iterator invoking "fcn" on each value assigned through it
+  template<typename Fcn>
+  struct function_output_iterator {
+    using iterator_category = std::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = void;
+    Fcn fcn;
+    function_output_iterator &operator=(const qnum value) { fcn(value); return *this; }
+    function_output_iterator &operator*()     { return *this; }
+    function_output_iterator &operator++()    { return *this; }
+    function_output_iterator &operator++(int) { return *this; }
+  };
+  template<typename Fcn>
+  function_output_iterator<Fcn> make_function_output(Fcn fcn) { return function_output_iterator<Fcn>{fcn}; }
+
+
+  /******************************************************************************
+  * COUNTER-BASED RANDOM NUMBERS
+  ******************************************************************************/
+
+  // Stateless generator: the nth draw of stream "s" under seed "k" is a pure fcn
+  // of (k,s,n), so work can be split across any # of threads (or resumed midway)
+  // & still reproduce the exact same values. Mixing uses the SplitMix64 finalizer.
+  struct counter_rng {
+    qnum seed = 0, stream = 0, counter = 0;
+
+    counter_rng() = default;
+    counter_rng(const qnum k, const qnum s = 0, const qnum n = 0) : seed(k), stream(s), counter(n) {}
+
+    static qnum mix(qnum z) {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+    // Draw #n of stream "s" under seed "k"
+    static qnum at(const qnum k, const qnum s, const qnum n) {
+      return mix(mix(k + 0x9e3779b97f4a7c15ULL * (s + 1)) ^ mix(n + 0x632be59bd9b4e019ULL));
+    }
+    // Draw #n of stream "s" under seed "k" as a double in [0,1)
+    static double uniform_at(const qnum k, const qnum s, const qnum n) {
+      return (at(k, s, n) >> 11) * (1.0 / 9007199254740992.0); // 53 bits / 2^53
+    }
+
+    qnum operator()() { return at(seed, stream, counter++); }
+    double uniform()  { return uniform_at(seed, stream, counter++); }
+  };
+
+
   /******************************************************************************
   * HYPERCUBE COMPUTATION STRUCTURE
   ******************************************************************************/
@@ -239,7 +607,7 @@ namespace qgraph {
     ******************************************************************************/
 
     qnum dimension = 0;
-    constexpr qnum total_points() const {return 1 << dimension;}
+    constexpr qnum total_points() const {return qnum(1) << dimension;}
 
     /******************************************************************************
     * CONSTRUCTORS
@@ -257,22 +625,16 @@ namespace qgraph {
     // IE: in a 3D cube, point #3 in the above diagram has coordinates: 
     //     (x,y,z) = (0,1,1) => 3 in binary
     qnums convert_point_to_coord(const qnum P) const {
-      if(!dimension || P > total_points()) return qnums{};
-      qnums P_coordinates;
-      for(qnum shift = dimension-1; shift >= 0; --shift) {
-        P_coordinates.push_back((P>>shift)&1);
-        if(!shift) return P_coordinates;
-      }
+      qnums P_coordinates(dimension);
+      if(!convert_point_to_coord(P, P_coordinates.begin())) return qnums{};
       return P_coordinates;
     }
 
 
     // Returns vector of points connected to P in this dimension
     qnums adjacent_points(const qnum P) const {
-      if(P > total_points()) return qnums{};
-      qnums points_connected_to_P;
-      for(qnum n = 0; n < dimension; ++n)
-        sorted_insert(points_connected_to_P, P^(1<<n)); 
+      qnums points_connected_to_P(dimension);
+      if(!adjacent_points(P, points_connected_to_P.begin())) return qnums{};
       return points_connected_to_P;
     }
 
@@ -280,15 +642,58 @@ namespace qgraph {
     // Returns vector of coordinates for points connected to P in this dimension.
     // NOTE: each coord is also a vector, hence this returns a MATRIX.
     qnum_matrix adjacent_coords(const qnum P) const {
-      if(P > total_points()) return qnum_matrix{};
-      qnum_matrix coords_of_points_connected_to_P;
-      const qnums P_adjacency_list(adjacent_points(P));
-
-      for(auto point : P_adjacency_list) 
-        coords_of_points_connected_to_P.push_back(convert_point_to_coord(point));
+      if(P >= total_points()) return qnum_matrix{};
+      qnum_matrix coords_of_points_connected_to_P(dimension, qnums(dimension));
+      qnum row = 0;
+      adjacent_points(P, make_function_output([&](qnum point) {
+        convert_point_to_coord(point, coords_of_points_connected_to_P[row++].begin());
+      }));
       return coords_of_points_connected_to_P;
     }
 
+    /******************************************************************************
+    * ALLOCATION-FREE POINT QUERIES (WRITE TO ANY OUTPUT ITERATOR, RETURN COUNTS)
+    ******************************************************************************/
+
+    // These write to a caller-provided output iterator (ie a raw buffer, a 
+    // std::span's or a reused vector's iterator, or a std::back_inserter) 
+    // rather than allocating a vector, & return the # of values written 
+    // (0 if "P" isn't in this dimension).
+
+    // Writes P's 'dimension' coordinates to "out"
+    template<typename OutputIt>
+    qnum convert_point_to_coord(const qnum P, OutputIt out) const {
+      if(!dimension || P >= total_points()) return 0;
+      for(qnum shift = dimension; shift-- > 0;) *out++ = (P >> shift) & 1;
+      return dimension;
+    }
+
+
+    // Writes the points connected to P to "out" in ascending order: the points 
+    // below P (clearing 1 of its set bits, highest bit 1st) then the points 
+    // above P (setting 1 of its clear bits, lowest bit 1st). No sorting needed.
+    template<typename OutputIt>
+    qnum adjacent_points(const qnum P, OutputIt out) const {
+      if(P >= total_points()) return 0;
+      for(qnum n = dimension; n-- > 0;) 
+        if((P >> n) & 1) *out++ = P ^ (qnum(1) << n);
+      for(qnum n = 0; n < dimension; ++n) 
+        if(!((P >> n) & 1)) *out++ = P | (qnum(1) << n);
+      return dimension;
+    }
+
+
+    // Writes the coords of the points connected to P to "out", flattened as 
+    // 'dimension' rows of 'dimension' values, & returns the # of rows (points)
+    template<typename OutputIt>
+    qnum adjacent_coords(const qnum P, OutputIt out) const {
+      if(P >= total_points()) return 0;
+      adjacent_points(P, make_function_output([&](qnum point) {
+        for(qnum shift = dimension; shift-- > 0;) *out++ = (point >> shift) & 1;
+      }));
+      return dimension;
+    }
+
     /******************************************************************************
     * ADJACENCY LIST MATRIX FOR ALL POINTS (OR COORDINATES) W/IN THIS HYPERCUBE
     ******************************************************************************/
@@ -297,9 +702,9 @@ namespace qgraph {
     // => M = point 
     // => matrix[M] = vector of points adjacent to M
     qnum_matrix point_adjacency_matrix() const {
-      qnum_matrix point_adjacency_lists;
+      qnum_matrix point_adjacency_lists(total_points(), qnums(dimension));
       for(qnum P = 0; P < total_points(); ++P)
-        point_adjacency_lists.push_back(adjacent_points(P));
+        adjacent_points(P, point_adjacency_lists[P].begin());
       return point_adjacency_lists;
     }
     
@@ -343,6 +748,8 @@ namespace qgraph {
     // NOTE: An n-cube is a vector of points composing the cube, hence this
     //       returns a MATRIX of points.
     qnum_matrix inner_cubes(const qnum n) const {
+      QGRAPH_CALL_SCOPE();
+      QGRAPH_TIME_PHASE(total_ns);
       if(n > dimension) return qnum_matrix{};
       qnum_matrix inner_cube_matrix;
       // 0th cubes are just points
@@ -352,7 +759,11 @@ namespace qgraph {
         return inner_cube_matrix;
       }
       // Derive nth sub-cubes from this cube's point adjacency list matrix.
-      qnum_matrix adj_matrix = point_adjacency_matrix();
+      qnum_matrix adj_matrix;
+      {
+        QGRAPH_TIME_PHASE(adjacency_matrix_ns);
+        adj_matrix = point_adjacency_matrix();
+      }
       for(qnum P = 0; P < total_points(); ++P)
         if(adj_matrix[P].size() >= n) {
           derive_all_n_cubes_containing_point_P(P,n,inner_cube_matrix,adj_matrix);
@@ -413,6 +824,176 @@ namespace qgraph {
     coord_matrix inner_cubes_coord(const Hypercube &h) const {
       return inner_cubes_coord(h.dimension);
     }
+
+    /******************************************************************************
+    * EDGE ENUMERATION & O(1) EDGE RANKING
+    ******************************************************************************/
+
+    // Total edges in 'dimension': N * 2^(N-1)
+    qnum total_edges() const {
+      return dimension ? dimension * (qnum(1) << (dimension - 1)) : 0;
+    }
+
+
+    // Returns the rank of edge (a,b) in [0,total_edges()), or total_edges() if
+    // "a" & "b" aren't adjacent in this dimension
+    qnum edge_rank(const qnum a, const qnum b) const {
+      const qnum diff = a ^ b;
+      if(!diff || (diff & (diff - 1)) || a >= total_points() || b >= total_points()) 
+        return total_edges();
+      const qnum d = qnum(__builtin_ctzll(diff));
+      return d * (qnum(1) << (dimension - 1)) + remove_bit(a & ~diff, d);
+    }
+    qnum edge_rank(const qedge &e) const { return edge_rank(e.first, e.second); }
+
+
+    // Returns the edge w/ the given rank as (lower point, higher point)
+    qedge edge_unrank(const qnum rank) const {
+      if(rank >= total_edges()) return qedge(0, 0);
+      return *edge_range::iterator(dimension, rank);
+    }
+
+
+    // Lazy sequences of all edges, or of the edges along dimension "d" (ie
+    // those joining points that differ only in bit "d")
+    edge_range lazy_edges() const { return edge_range{dimension, 0, total_edges()}; }
+    edge_range lazy_dimension_edges(const qnum d) const {
+      if(d >= dimension) return edge_range{dimension, 0, 0};
+      const qnum slice = qnum(1) << (dimension - 1);
+      return edge_range{dimension, d * slice, (d + 1) * slice};
+    }
+
+
+    // Bulk versions of the above, in rank order
+    qedges edges() const { return collect_edges(lazy_edges()); }
+    qedges dimension_edges(const qnum d) const { return collect_edges(lazy_dimension_edges(d)); }
+
+    /******************************************************************************
+    * LARGEST INNER CUBES CONTAINED W/IN AN ARBITRARY SET OF POINTS
+    ******************************************************************************/
+
+    // Returns the sorted points composing subcube "c"
+    qnums subcube_points(const subcube &c) const {
+      qnums points;
+      qnum sub = 0;
+      do { // enumerates the submasks of "free_mask" in increasing order
+        points.push_back(c.base | sub);
+        sub = (sub - c.free_mask) & c.free_mask;
+      } while(sub);
+      return points;
+    }
+
+    // Returns every subcube of the greatest dimension lying fully w/in "points".
+    // "threads = 0" uses all hardware threads. Level-by-level DP is used unless
+    // it would need more than "memory_limit" bytes, in which case a depth-first
+    // search holding only O(N * 2^N) bits per thread is used instead.
+    // Dimensions > 32 yield no subcubes (as do the other bitset-backed methods).
+    subcubes largest_inner_cubes_within(const qnums &points, const qnum threads = 0, 
+                                        const qnum memory_limit = qnum(1) << 30) const;
+
+    // Returns every subcube lying w/in "points" that isn't w/in a larger such subcube
+    // (same threading, memory, & dimension > 32 rules as above)
+    subcubes maximal_inner_cubes_within(const qnums &points, const qnum threads = 0, 
+                                        const qnum memory_limit = qnum(1) << 30) const;
+
+    /******************************************************************************
+    * UNIFORM RANDOM SAMPLING OF POINTS, SUBCUBES, & SHORTEST PATHS: O(N) EACH
+    ******************************************************************************/
+
+    // Every sample reads "rng" at counters [rng.counter, rng.counter + sample_stride())
+    // then advances it by sample_stride(). Hence sample #i of a batch is a pure fcn
+    // of (seed, stream, counter + i * sample_stride()): a batch split across threads
+    // (each starting its rng at its 1st sample's counter) reproduces the same values,
+    // as does giving each thread its own stream.
+    qnum sample_stride() const { return dimension + 1; }
+
+
+    // Uniform over all total_points() points
+    qnum random_point(counter_rng &rng) const {
+      const qnum point = counter_rng::at(rng.seed, rng.stream, rng.counter) & point_mask();
+      rng.counter += sample_stride();
+      return point;
+    }
+
+
+    // Uniform over all total_inner_cubes(n) n-cubes (returns {0,0} if n > dimension):
+    // picks the n free dimensions by selection sampling, then the fixed bits at random
+    subcube random_subcube(const qnum n, counter_rng &rng) const {
+      subcube c;
+      if(n > dimension) return c;
+      const qnum base = rng.counter;
+      for(qnum d = 0, needed = n; d < dimension && needed; ++d)
+        if(counter_rng::uniform_at(rng.seed, rng.stream, base + d) * (dimension - d) < needed)
+          c.free_mask |= qnum(1) << d, --needed;
+      c.base = counter_rng::at(rng.seed, rng.stream, base + dimension) & point_mask() & ~c.free_mask;
+      rng.counter += sample_stride();
+      return c;
+    }
+
+
+    // Writes a uniformly random one of the k! shortest paths from point a to point 
+    // b (excluding a, like "shortest_path") to "out" & returns its length k
+    template<typename OutputIt>
+    qnum random_shortest_path(const qnum a, const qnum b, counter_rng &rng, OutputIt out) const {
+      write_random_shortest_path(a, b, rng, out);
+      return qnum(__builtin_popcountll((a ^ b) & point_mask()));
+    }
+    qnums random_shortest_path(const qnum a, const qnum b, counter_rng &rng) const {
+      qnums path;
+      path.reserve(__builtin_popcountll(a ^ b));
+      random_shortest_path(a, b, rng, std::back_inserter(path));
+      return path;
+    }
+
+
+    // Batched versions of the above: write "count" samples to "out" (paths are 
+    // written back-to-back) & return the # of samples written
+    template<typename OutputIt>
+    qnum random_points(const qnum count, counter_rng &rng, OutputIt out) const {
+      for(qnum i = 0; i < count; ++i) *out++ = random_point(rng);
+      return count;
+    }
+    template<typename OutputIt>
+    qnum random_subcubes(const qnum n, const qnum count, counter_rng &rng, OutputIt out) const {
+      if(n > dimension) return 0;
+      for(qnum i = 0; i < count; ++i) *out++ = random_subcube(n, rng);
+      return count;
+    }
+    template<typename OutputIt>
+    qnum random_shortest_paths(const qnum a, const qnum b, const qnum count, counter_rng &rng, OutputIt out) const {
+      for(qnum i = 0; i < count; ++i) out = write_random_shortest_path(a, b, rng, out);
+      return count;
+    }
+
+  private:
+    // Edge ranges only claim input iterators, so size the vector up front
+    // rather than have it grow 1 push_back at a time
+    static qedges collect_edges(const edge_range &range) {
+      qedges out;
+      out.reserve(range.size());
+      for(auto e : range) out.push_back(e);
+      return out;
+    }
+    qnum point_mask() const { return (dimension >= 64) ? ~qnum(0) : total_points() - 1; }
+    // Uniform in [0,range) from draw #(rng.counter + j), via a 64x64->128 bit multiply
+    static qnum bounded_draw(const counter_rng &rng, const qnum j, const qnum range) {
+      return mulhi(counter_rng::at(rng.seed, rng.stream, rng.counter + j), range);
+    }
+    // Body of "random_shortest_path", returning "out" advanced past the path so
+    // batches can keep writing through single-pass iterators
+    template<typename OutputIt>
+    OutputIt write_random_shortest_path(const qnum a, const qnum b, counter_rng &rng, OutputIt out) const {
+      qnum flips[64], k = 0;
+      for(qnum d = 0; d < dimension && d < 64; ++d)
+        if(((a ^ b) >> d) & 1) flips[k++] = d;
+      for(qnum i = k; i > 1; --i) // Fisher-Yates shuffle of the dimensions to flip
+        std::swap(flips[i-1], flips[bounded_draw(rng, k - i, i)]);
+      qnum current_point = a;
+      for(qnum i = 0; i < k; ++i)
+        *out++ = (current_point ^= qnum(1) << flips[i]);
+      rng.counter += sample_stride();
+      return out;
+    }
   };
 
 
@@ -423,6 +1004,7 @@ namespace qgraph {
 
   // Rm row & instances of point "P" in "adj_matrix" (found all cubes containing it)
   void Hypercube::erase_seen_point_P_from_adjMatrix(const qnum P,qnum_matrix &adj_matrix)const {
+    QGRAPH_TIME_PHASE(erase_seen_point_P_ns);
     adj_matrix[P].clear();
     for(qnum row = 0; row < total_points(); ++row) 
       sorted_erase(adj_matrix[row], P);
@@ -432,6 +1014,7 @@ namespace qgraph {
   // Rm points already seen in dimension (only searching for new pts)
   void Hypercube::erase_seen_points(const qnums &seen, 
   qnum_matrix &shared_point_adjacency_lists) const {
+    QGRAPH_TIME_PHASE(erase_seen_points_ns);
     for(auto point : seen) 
       for(qnums &adj_list : shared_point_adjacency_lists) 
         sorted_erase(adj_list, point);
@@ -443,9 +1026,10 @@ namespace qgraph {
   void Hypercube::register_and_derive_shared_point_adjacency_lists(qnums &seen_points,
   qnum_matrix &shared_point_adjacency_lists, const qnums &cube_points, 
   const qnum_matrix &adj_matrix) const {
+    QGRAPH_TIME_PHASE(register_points_ns);
     shared_point_adjacency_lists.clear();
     for(auto point : cube_points) {
-      shared_point_adjacency_lists.push_back(adj_matrix[point]);
+      QGRAPH_TRACK_GROWTH(shared_point_adjacency_lists, shared_point_adjacency_lists.push_back(adj_matrix[point]));
       sorted_insert(seen_points, point);
     }
   }
@@ -455,6 +1039,7 @@ namespace qgraph {
   // other rows, return set of these shared elts --- else, return empty set
   void Hypercube::derive_shared_cube_points(const qnum n,const qnum edge,
   qnums &cube_points,const qnum_matrix &shared_point_adjacency_lists) const {
+    QGRAPH_TIME_PHASE(derive_shared_points_ns);
     cube_points.clear(); // holds the next set of shared points (if exists)
     qnum alist_idx = 0, other_alist_idx = 0;
     qnum shared_point_count = 0, shared_with_count = 0;
@@ -487,7 +1072,11 @@ namespace qgraph {
   qnum_matrix &inner_cube_matrix, qnum_matrix &adj_matrix) const {
     // Get "n" length combinations of P's values to try and form cubes w/
     qnum_matrix potential_cube_points_set;
-    get_n_combinations_in_range(n,adj_matrix[P].begin(),adj_matrix[P].end(),{},potential_cube_points_set);
+    {
+      QGRAPH_TIME_PHASE(combinations_ns);
+      get_n_combinations_in_range(n,adj_matrix[P].begin(),adj_matrix[P].end(),{},potential_cube_points_set);
+    }
+    QGRAPH_COUNT(candidate_combinations, potential_cube_points_set.size());
 
     qnum_matrix shared_point_adjacency_lists;
     qnums seen_points;
@@ -513,8 +1102,1336 @@ namespace qgraph {
 
       // If the above loop was never broken, P & its "cube_points" indeed seeded an n-cube. 
       // This n-cube's points were all registered w/in "seen_points" while verifying its existence.
-      if(!edge) sorted_insert(inner_cube_matrix, seen_points);
+      if(!edge) {
+        sorted_insert(inner_cube_matrix, seen_points);
+        QGRAPH_COUNT(cubes_found, 1);
+      } else {
+        QGRAPH_COUNT(rejected_combinations, 1);
+      }
+    }
+  }
+
+
+  /******************************************************************************
+  * DENSE EDGE-INDEXED ARRAY
+  ******************************************************************************/
+
+  // One "T" per edge of a Hypercube, stored contiguously in edge-rank order.
+  // Per-link counters can thus live in 1 array instead of a map keyed by point
+  // pairs, & each dimension's edges form 1 contiguous slice.
+  template<typename T>
+  struct edge_array {
+    Hypercube cube;
+    std::vector<T> values;
+
+    // rank of edge (a,b), asserting that it exists
+    qnum checked_rank(const qnum a, const qnum b) const {
+      const qnum rank = cube.edge_rank(a, b);
+      assert(rank < values.size() && "edge_array: endpoints aren't adjacent");
+      return rank;
+    }
+
+    edge_array() = default;
+    edge_array(const Hypercube &h, const T &init = T()) : cube(h), values(h.total_edges(), init) {}
+
+    qnum size() const { return values.size(); }
+    T *data() { return values.data(); }
+    const T *data() const { return values.data(); }
+    void fill(const T &value) { std::fill(values.begin(), values.end(), value); }
+
+    // Access by edge rank, or by the edge's endpoints (in either order). 
+    // PRECONDITION: the endpoints must be adjacent in the cube (else their rank is
+    // the sentinel "total_edges()", past the last value: asserted against). "at()"
+    // checks instead, throwing std::out_of_range for non-adjacent endpoints.
+    T &operator[](const qnum rank) { return values[rank]; }
+    const T &operator[](const qnum rank) const { return values[rank]; }
+    T &operator()(const qnum a, const qnum b) { return values[checked_rank(a, b)]; }
+    const T &operator()(const qnum a, const qnum b) const { return values[checked_rank(a, b)]; }
+    T &operator()(const qedge &e) { return values[checked_rank(e.first, e.second)]; }
+    const T &operator()(const qedge &e) const { return values[checked_rank(e.first, e.second)]; }
+    T &at(const qnum a, const qnum b) { return values.at(cube.edge_rank(a, b)); }
+    const T &at(const qnum a, const qnum b) const { return values.at(cube.edge_rank(a, b)); }
+    T &at(const qedge &e) { return values.at(cube.edge_rank(e)); }
+    const T &at(const qedge &e) const { return values.at(cube.edge_rank(e)); }
+
+    // Iterators over every value, or over the values of dimension "d"'s edges
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end()   { return values.end();   }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end()   const { return values.end();   }
+    typename std::vector<T>::iterator dimension_begin(const qnum d) { return values.begin() + cube.lazy_dimension_edges(d).first; }
+    typename std::vector<T>::iterator dimension_end(const qnum d)   { return values.begin() + cube.lazy_dimension_edges(d).last;  }
+    typename std::vector<T>::const_iterator dimension_begin(const qnum d) const { return values.begin() + cube.lazy_dimension_edges(d).first; }
+    typename std::vector<T>::const_iterator dimension_end(const qnum d)   const { return values.begin() + cube.lazy_dimension_edges(d).last;  }
+  };
+
+
+  /******************************************************************************
+  * PRIVATE INNER-CUBES-WITHIN-POINTS BITSET DP ENGINE --- USERS DISREGARD
+  ******************************************************************************/
+
+  // Each (free_mask M, base) state of the 3^N subcubes is a bit in g_M: a 2^N-bit
+  // set w/ bit v on iff every point reachable from v by flipping M's bits is w/in
+  // the point set. Freeing dimension d costs 1 word-parallel pass over g_M:
+  //   g_{M+d}[v] = g_M[v] & g_M[v ^ 2^d]
+  struct inner_cube_dp {
+    using bitset = std::vector<std::uint64_t>;
+    qnum N, words, threads;
+    bitset S;
+
+    inner_cube_dp(const qnum dimension, const qnums &points, const qnum thread_count)
+      : N(dimension), words(((qnum(1) << dimension) + 63) / 64), threads(thread_count), S(words, 0) {
+      if(!threads) threads = std::thread::hardware_concurrency();
+      if(!threads) threads = 1;
+      for(auto P : points) 
+        if(P < (qnum(1) << N)) S[P >> 6] |= qnum(1) << (P & 63);
+    }
+
+    // out = g_{M+d} given in = g_M, returns whether any bit is left on
+    bool widen(const bitset &in, bitset &out, const qnum d) const {
+      std::uint64_t any = 0;
+      if(d >= 6) {
+        const qnum stride = qnum(1) << (d - 6);
+        for(qnum w = 0; w < words; ++w) any |= (out[w] = in[w] & in[w ^ stride]);
+      } else {
+        static const std::uint64_t masks[6] = {
+          0x5555555555555555ULL, 0x3333333333333333ULL, 0x0f0f0f0f0f0f0f0fULL,
+          0x00ff00ff00ff00ffULL, 0x0000ffff0000ffffULL, 0x00000000ffffffffULL
+        };
+        const std::uint64_t m = masks[d];
+        const qnum shift = qnum(1) << d;
+        for(qnum w = 0; w < words; ++w) {
+          const std::uint64_t x = in[w];
+          any |= (out[w] = x & (((x >> shift) & m) | ((x & m) << shift)));
+        }
+      }
+      return any != 0;
+    }
+
+    // Appends (M, v) for each bit v on in "g" that is its subcube's base (v & M == 0)
+    static void collect(const bitset &g, const qnum M, subcubes &out) {
+      for(qnum w = 0; w < g.size(); ++w)
+        for(std::uint64_t bits = g[w]; bits; bits &= bits - 1) {
+          const qnum v = (w << 6) | qnum(__builtin_ctzll(bits));
+          if(!(v & M)) out.push_back(subcube{M, v});
+        }
+    }
+    // "g" & ~(union of g_{M+d} for each d not in M): the states not w/in a bigger cube
+    void uncovered(const bitset &g, const qnum M, bitset &scratch, bitset &result) const {
+      result = g;
+      for(qnum d = 0; d < N; ++d) {
+        if((M >> d) & 1) continue;
+        if(widen(g, scratch, d))
+          for(qnum w = 0; w < words; ++w) result[w] &= ~scratch[w];
+      }
+    }
+
+    static void sort_subcubes(subcubes &cubes) {
+      std::sort(cubes.begin(), cubes.end(), [](const subcube &a, const subcube &b) {
+        return (a.free_mask != b.free_mask) ? a.free_mask < b.free_mask : a.base < b.base;
+      });
+    }
+
+    // Bytes the level-by-level DP needs for 2 adjacent levels at once
+    qnum level_memory() const {
+      double binom = 1, peak = 0;
+      for(qnum k = 0; k < N; ++k) {
+        const double next = binom * double(N - k) / double(k + 1);
+        peak = std::max(peak, binom + next);
+        binom = next;
+      }
+      return qnum(peak * double(words) * 8.0) + (qnum(1) << N) * sizeof(std::uint32_t);
+    }
+
+
+    // Level-by-level: level k+1's bitsets come from level k's (each mask drops its
+    // highest bit to find its parent). Masks w/ empty bitsets are stored empty.
+    subcubes run_levels(const bool maximal) const {
+      subcubes result;
+      std::vector<std::uint32_t> position(qnum(1) << N, 0);
+      qnums masks{0}, next_masks;
+      std::vector<bitset> level{S}, next_level;
+      if(!std::any_of(S.begin(), S.end(), [](std::uint64_t w){return w != 0;})) return result;
+
+      for(qnum k = 0; k <= N; ++k) {
+        // derive level k+1
+        next_masks.clear();
+        if(k < N)
+          for(qnum M = 0; M < (qnum(1) << N); ++M)
+            if(qnum(__builtin_popcountll(M)) == k + 1) position[M] = std::uint32_t(next_masks.size()), next_masks.push_back(M);
+        next_level.assign(next_masks.size(), bitset{});
+        std::atomic<bool> next_nonempty(false);
+        parallel_for_ranges(next_masks.size(), threads, [&](qnum lo, qnum hi, qnum) {
+          for(qnum i = lo; i < hi; ++i) {
+            const qnum M = next_masks[i], d = 63 - qnum(__builtin_clzll(M));
+            const bitset &parent = level[position[M ^ (qnum(1) << d)]];
+            if(parent.empty()) continue;
+            bitset child(words);
+            if(widen(parent, child, d)) next_level[i].swap(child), next_nonempty = true;
+          }
+        });
+
+        // harvest level k
+        if(maximal) {
+          std::vector<subcubes> found(threads);
+          parallel_for_ranges(masks.size(), threads, [&](qnum lo, qnum hi, qnum t) {
+            bitset covered(words), scratch(words);
+            for(qnum i = lo; i < hi; ++i) {
+              if(level[i].empty()) continue;
+              covered = level[i];
+              for(qnum d = 0; d < N; ++d) {
+                if((masks[i] >> d) & 1) continue;
+                const bitset &wider = next_level[position[masks[i] | (qnum(1) << d)]];
+                if(!wider.empty()) for(qnum w = 0; w < words; ++w) covered[w] &= ~wider[w];
+              }
+              collect(covered, masks[i], found[t]);
+            }
+          });
+          for(auto &cubes : found) result.insert(result.end(), cubes.begin(), cubes.end());
+        } else if(!next_nonempty) {
+          for(qnum i = 0; i < masks.size(); ++i) 
+            if(!level[i].empty()) collect(level[i], masks[i], result);
+        }
+
+        if(!next_nonempty) break;
+        for(qnum i = 0; i < next_masks.size(); ++i) position[next_masks[i]] = std::uint32_t(i);
+        masks.swap(next_masks), level.swap(next_level);
+      }
+      sort_subcubes(result);
+      return result;
     }
+
+
+    // Depth-first: masks grow by bits above their highest bit, so each mask is
+    // reached once & an empty bitset prunes its whole subtree. Subtrees rooted at
+    // each mask w/ min(3,N) bits are dynamically scheduled across threads.
+    subcubes run_dfs(const bool maximal) const {
+      const qnum seed_bits = std::min<qnum>(3, N);
+      qnums seeds;
+      for(qnum M = 0; M < (qnum(1) << N); ++M) // masks w/ "seed_bits" bits in increasing order
+        if(qnum(__builtin_popcountll(M)) <= seed_bits) seeds.push_back(M);
+
+      struct thread_state { qnum best = 0; bool any = false; subcubes found; };
+      std::vector<thread_state> states(threads);
+      std::atomic<qnum> next_seed(0);
+
+      parallel_for_ranges(threads, threads, [&](qnum, qnum, qnum t) {
+        thread_state &state = states[t];
+        std::vector<bitset> stack(N + 2, bitset(words));
+        bitset scratch(words), result(words);
+
+        auto visit = [&](const bitset &g, const qnum M) {
+          const qnum k = __builtin_popcountll(M);
+          if(maximal) {
+            uncovered(g, M, scratch, result);
+            collect(result, M, state.found);
+          } else if(!state.any || k >= state.best) {
+            if(!state.any || k > state.best) state.found.clear(), state.best = k, state.any = true;
+            collect(g, M, state.found);
+          }
+        };
+        // explicit-stack DFS (depth <= N): level i holds its bitset in stack[i], its
+        // mask in masks[i], & the next dimension to free from it in next_dims[i]
+        qnums masks(N + 2), next_dims(N + 2);
+        auto descend = [&](const qnum M, const qnum depth, const qnum from) {
+          masks[depth] = M, next_dims[depth] = from;
+          for(qnum top = depth;;) {
+            if(next_dims[top] >= N) {
+              if(top == depth) break;
+              --top;
+              continue;
+            }
+            const qnum d = next_dims[top]++;
+            if(widen(stack[top], stack[top + 1], d)) {
+              masks[top + 1] = masks[top] | (qnum(1) << d), next_dims[top + 1] = d + 1;
+              visit(stack[top + 1], masks[top + 1]);
+              ++top;
+            }
+          }
+        };
+
+        for(qnum i; (i = next_seed.fetch_add(1)) < seeds.size();) {
+          const qnum M = seeds[i];
+          stack[0] = S;
+          bool nonempty = std::any_of(S.begin(), S.end(), [](std::uint64_t w){return w != 0;});
+          qnum depth = 0;
+          for(qnum d = 0; nonempty && d < N; ++d)
+            if((M >> d) & 1) nonempty = widen(stack[depth], stack[depth + 1], d), ++depth;
+          if(!nonempty) continue;
+          visit(stack[depth], M);
+          if(qnum(__builtin_popcountll(M)) == seed_bits)
+            descend(M, depth, M ? 64 - qnum(__builtin_clzll(M)) : 0);
+        }
+      });
+
+      subcubes result;
+      qnum best = 0;
+      for(auto &state : states) if(state.any && state.best > best) best = state.best;
+      for(auto &state : states)
+        if(maximal || (state.any && state.best == best))
+          result.insert(result.end(), state.found.begin(), state.found.end());
+      sort_subcubes(result);
+      return result;
+    }
+  };
+
+
+  subcubes Hypercube::largest_inner_cubes_within(const qnums &points, const qnum threads, const qnum memory_limit) const {
+    if(dimension > 32) return subcubes{}; // 2^N-bit sets (& 2^N masks) would overflow memory
+    const inner_cube_dp dp(dimension, points, threads);
+    return (dp.level_memory() <= memory_limit) ? dp.run_levels(false) : dp.run_dfs(false);
+  }
+
+
+  subcubes Hypercube::maximal_inner_cubes_within(const qnums &points, const qnum threads, const qnum memory_limit) const {
+    if(dimension > 32) return subcubes{}; // 2^N-bit sets (& 2^N masks) would overflow memory
+    const inner_cube_dp dp(dimension, points, threads);
+    return (dp.level_memory() <= memory_limit) ? dp.run_levels(true) : dp.run_dfs(true);
   }
+
+
+  /******************************************************************************
+  * PERCOLATION (RANDOM VERTEX/EDGE FAILURE) SIMULATION
+  ******************************************************************************/
+
+  enum failure_modes {VERTEX_FAILURES, EDGE_FAILURES, VERTEX_AND_EDGE_FAILURES};
+
+  // Result of a single trial at a single failure probability "p"
+  struct percolation_sample {
+    double p = 0;              // failure probability
+    qnum trial = 0;            // trial index (selects the trial's random streams)
+    qnum alive_points = 0;     // # of vertices that survived
+    qnum components = 0;       // # of connected components among surviving vertices
+    qnum largest_component = 0;
+    double giant_fraction = 0; // largest_component / total_points()
+    qnums size_histogram;      // [b] = # of components w/ a size in [2^b, 2^(b+1))
+  };
+  using percolation_samples = std::vector<percolation_sample>;
+
+
+  // Monte Carlo estimation of a Hypercube's connectivity under random failures.
+  // Each vertex & edge draws a uniform "u" from "counter_rng" keyed by its label,
+  // & survives iff u >= p. Since survival is monotone in p, a trial's sweep over
+  // several p's runs from the largest p down: each step only unions the edges
+  // newly surviving at that p into the previous step's union-find, rather than
+  // restarting it. Results are identical for any # of threads.
+  struct Percolation {
+    Hypercube cube;
+    failure_modes mode = VERTEX_AND_EDGE_FAILURES;
+    qnum seed = 0;
+    qnum threads = 0; // 0 => std::thread::hardware_concurrency()
+
+    Percolation() = default;
+    Percolation(const Hypercube &h, const failure_modes m = VERTEX_AND_EDGE_FAILURES, const qnum k = 0) 
+      : cube(h), mode(m), seed(k) {}
+    Percolation(const Percolation &sim) : cube(sim.cube), mode(sim.mode), seed(sim.seed), threads(sim.threads) {}
+
+
+    // Returns one sample per "ps" elt (in the same order) for trial "trial"
+    percolation_samples run_trial(const std::vector<double> &ps, const qnum trial) {
+      if(ps.empty() || cube.dimension > 32) return percolation_samples{};
+      const qnum n = cube.total_points(), dim = cube.dimension, workers = worker_count();
+      reset_union_find(n, workers);
+
+      std::vector<qnum> order(ps.size());
+      for(qnum i = 0; i < order.size(); ++i) order[i] = i;
+      std::stable_sort(order.begin(), order.end(), [&](qnum a, qnum b){return ps[a] > ps[b];});
+
+      percolation_samples samples(ps.size());
+      double previous_p = 2.0; // above every draw, so the 1st step adds all survivors
+      for(auto idx : order) {
+        const double p = ps[idx];
+        // union the edges that survive at "p" but didn't at "previous_p"
+        parallel_for_ranges(n, workers, [&](qnum lo, qnum hi, qnum) {
+          for(qnum v = lo; v < hi; ++v)
+            for(qnum d = 0; d < dim; ++d) {
+              const qnum w = v | (qnum(1) << d);
+              if(w == v) continue; // edge already visited from its lower endpoint
+              const double key = edge_key(trial, v, w, d);
+              if(key >= p && key < previous_p) unite(v, w);
+            }
+        });
+        samples[idx] = tally_components(p, trial, n, workers);
+        previous_p = p;
+      }
+      return samples;
+    }
+
+
+    // Runs "trials" independent trials, returning all their samples (trial-major)
+    percolation_samples simulate(const std::vector<double> &ps, const qnum trials) {
+      percolation_samples samples;
+      samples.reserve(ps.size() * trials);
+      for(qnum trial = 0; trial < trials; ++trial) {
+        percolation_samples trial_samples = run_trial(ps, trial);
+        samples.insert(samples.end(), trial_samples.begin(), trial_samples.end());
+      }
+      return samples;
+    }
+
+  private:
+    // flat union-find over the 2^N labels (+ per-root component sizes while tallying)
+    std::unique_ptr<std::atomic<std::uint32_t>[]> parent, sizes;
+    qnum allocated_points = 0;
+
+    qnum worker_count() const {
+      if(threads) return threads;
+      const qnum hw = std::thread::hardware_concurrency();
+      return hw ? hw : 1;
+    }
+
+    // Survival draws: vertices use stream 2*trial, edges use stream 2*trial+1
+    double vertex_draw(const qnum trial, const qnum v) const {
+      return (mode == EDGE_FAILURES) ? 1.0 : counter_rng::uniform_at(seed, 2*trial, v);
+    }
+    // An edge is usable iff it & both of its endpoints survive
+    double edge_key(const qnum trial, const qnum v, const qnum w, const qnum d) const {
+      const double ev = (mode == VERTEX_FAILURES) ? 1.0 : counter_rng::uniform_at(seed, 2*trial+1, v*cube.dimension+d);
+      return std::min(ev, std::min(vertex_draw(trial, v), vertex_draw(trial, w)));
+    }
+
+    void reset_union_find(const qnum n, const qnum workers) {
+      if(allocated_points != n) {
+        parent.reset(new std::atomic<std::uint32_t>[n]);
+        sizes.reset(new std::atomic<std::uint32_t>[n]);
+        allocated_points = n;
+      }
+      parallel_for_ranges(n, workers, [&](qnum lo, qnum hi, qnum) {
+        for(qnum v = lo; v < hi; ++v) parent[v].store(std::uint32_t(v), std::memory_order_relaxed);
+      });
+    }
+
+    // Lock-free find w/ path halving
+    std::uint32_t find(std::uint32_t x) const {
+      for(;;) {
+        std::uint32_t p = parent[x].load(std::memory_order_relaxed);
+        if(p == x) return x;
+        const std::uint32_t gp = parent[p].load(std::memory_order_relaxed);
+        if(p != gp) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        x = gp;
+      }
+    }
+    // Lock-free union: always links the larger root label under the smaller one
+    void unite(qnum a, qnum b) {
+      std::uint32_t ra = std::uint32_t(a), rb = std::uint32_t(b);
+      for(;;) {
+        ra = find(ra), rb = find(rb);
+        if(ra == rb) return;
+        if(ra < rb) std::swap(ra, rb);
+        std::uint32_t expected = ra;
+        if(parent[ra].compare_exchange_strong(expected, rb, std::memory_order_relaxed)) return;
+      }
+    }
+
+    // Count every surviving vertex toward its root, then reduce the root sizes
+    percolation_sample tally_components(const double p, const qnum trial, const qnum n, const qnum workers) {
+      parallel_for_ranges(n, workers, [&](qnum lo, qnum hi, qnum) {
+        for(qnum v = lo; v < hi; ++v) sizes[v].store(0, std::memory_order_relaxed);
+      });
+      parallel_for_ranges(n, workers, [&](qnum lo, qnum hi, qnum) {
+        for(qnum v = lo; v < hi; ++v)
+          if(vertex_draw(trial, v) >= p) sizes[find(std::uint32_t(v))].fetch_add(1, std::memory_order_relaxed);
+      });
+
+      std::vector<percolation_sample> partials(workers);
+      parallel_for_ranges(n, workers, [&](qnum lo, qnum hi, qnum t) {
+        percolation_sample &part = partials[t];
+        part.size_histogram.assign(33, 0);
+        for(qnum v = lo; v < hi; ++v) {
+          const qnum size = sizes[v].load(std::memory_order_relaxed);
+          if(!size) continue;
+          part.alive_points += size, ++part.components;
+          if(size > part.largest_component) part.largest_component = size;
+          qnum bin = 0;
+          while(size >> (bin + 1)) ++bin;
+          ++part.size_histogram[bin];
+        }
+      });
+
+      percolation_sample sample;
+      sample.p = p, sample.trial = trial;
+      sample.size_histogram.assign(33, 0);
+      for(auto &part : partials) {
+        if(part.size_histogram.empty()) continue; // unused worker slot
+        sample.alive_points += part.alive_points;
+        sample.components += part.components;
+        if(part.largest_component > sample.largest_component) sample.largest_component = part.largest_component;
+        for(qnum bin = 0; bin < part.size_histogram.size(); ++bin) sample.size_histogram[bin] += part.size_histogram[bin];
+      }
+      while(!sample.size_histogram.empty() && !sample.size_histogram.back()) sample.size_histogram.pop_back();
+      sample.giant_fraction = double(sample.largest_component) / double(n);
+      return sample;
+    }
+  };
+
+
+  /******************************************************************************
+  * BINARY STREAMING EXPORT (EDGE LISTS, CSR ADJACENCY, SUBCUBE LISTS)
+  ******************************************************************************/
+
+  /*
+   * FILE FORMAT (all fixed-width ints little-endian):
+   *   HEADER (32 bytes): "QGRB" | u8 version | u8 kind | u8 dimension | u8 0 |
+   *                      u64 total records | u64 total chunks | u64 payload bytes
+   *   CHUNKS:            u32 payload bytes | u32 records | payload
+   *
+   * Payloads are LEB128 varints, delta-coded against the previous record of the
+   * same chunk (so every chunk decodes independently). Signed deltas are zigzag
+   * coded & a neighbor "w" of point "v" is coded as (d << 1) if w = v ^ 2^d, else
+   * as (zigzag(w - v) << 1) | 1, so hypercube edges take ~2 bytes apiece:
+   *   EDGE_LIST:     zigzag(from - prev_from), neighbor code of "to" from "from"
+   *   CSR_ADJACENCY: zigzag(P - prev_P), degree, neighbor code of each neighbor
+   *   SUBCUBE_LIST:  zigzag(free_mask - prev_free_mask), zigzag(base - prev_base)
+   */
+
+  enum binary_kinds {EDGE_LIST, CSR_ADJACENCY, SUBCUBE_LIST};
+
+
+  // Streams records to a file in fixed-size chunks: at most 1 chunk is ever 
+  // held in memory. The header's totals are patched in by "close()".
+  class binary_writer {
+    std::ofstream file;
+    binary_kinds file_kind;
+    qnum file_dimension, chunk_bytes;
+    qnum total_records = 0, total_chunks = 0, payload_bytes = 0;
+    std::vector<unsigned char> chunk;
+    qnum chunk_records = 0, prev_a = 0, prev_b = 0;
+
+    void put_varint(qnum x) {
+      while(x >= 0x80) chunk.push_back((unsigned char)(x | 0x80)), x >>= 7;
+      chunk.push_back((unsigned char)x);
+    }
+    static qnum zigzag(const qnum x) { return (x << 1) ^ qnum(-std::int64_t(x >> 63)); }
+    void put_neighbor(const qnum v, const qnum w) {
+      const qnum diff = v ^ w;
+      if(diff && !(diff & (diff - 1))) put_varint(qnum(__builtin_ctzll(diff)) << 1);
+      else put_varint((zigzag(w - v) << 1) | 1);
+    }
+    void put_fixed(unsigned char *dest, qnum x, const qnum bytes) {
+      for(qnum i = 0; i < bytes; ++i) dest[i] = (unsigned char)(x & 0xff), x >>= 8;
+    }
+    void write_header() {
+      unsigned char header[32] = {'Q','G','R','B', 1, (unsigned char)file_kind, (unsigned char)file_dimension, 0};
+      put_fixed(header + 8, total_records, 8);
+      put_fixed(header + 16, total_chunks, 8);
+      put_fixed(header + 24, payload_bytes, 8);
+      file.write(reinterpret_cast<const char*>(header), 32);
+    }
+    void end_record() {
+      ++chunk_records;
+      if(chunk.size() >= chunk_bytes || !file) flush();
+    }
+
+  public:
+    binary_writer(const std::string &path, const binary_kinds kind, const qnum dimension, 
+                  const qnum chunk_size = qnum(1) << 20)
+      : file(path, std::ios::binary | std::ios::trunc), file_kind(kind), 
+        file_dimension(dimension), chunk_bytes(chunk_size ? chunk_size : 1) {
+      chunk.reserve(chunk_bytes + 32);
+      if(file) write_header(); // placeholder totals until "close()"
+    }
+    binary_writer(const binary_writer &) = delete;
+    binary_writer &operator=(const binary_writer &) = delete;
+    ~binary_writer() { close(); }
+
+    bool good() const { return bool(file); }
+    qnum records() const { return total_records + chunk_records; }
+
+
+    // Record writers (each must match the writer's kind)
+    void write_edge(const qnum from, const qnum to) {
+      put_varint(zigzag(from - prev_a)), put_neighbor(from, to);
+      prev_a = from;
+      end_record();
+    }
+    void write_edge(const qedge &e) { write_edge(e.first, e.second); }
+
+    template<typename InputIt>
+    void write_adjacency(const qnum P, InputIt first, InputIt last) {
+      put_varint(zigzag(P - prev_a)), put_varint(qnum(std::distance(first, last)));
+      for(; first != last; ++first) put_neighbor(P, *first);
+      prev_a = P;
+      end_record();
+    }
+    void write_adjacency(const qnum P, const qnums &adjacent) { write_adjacency(P, adjacent.begin(), adjacent.end()); }
+
+    void write_subcube(const subcube &c) {
+      put_varint(zigzag(c.free_mask - prev_a)), put_varint(zigzag(c.base - prev_b));
+      prev_a = c.free_mask, prev_b = c.base;
+      end_record();
+    }
+    // Given an inner cube's points (ie a row of "inner_cubes(n)")
+    void write_cube(const qnums &points) {
+      if(points.empty()) return;
+      qnum free_mask = 0;
+      for(auto point : points) free_mask |= point ^ points[0];
+      write_subcube(subcube{free_mask, points[0] & ~free_mask});
+    }
+
+
+    // Writes the pending chunk (if any) to the file, or drops it once the file
+    // has failed (so a failed writer never holds more than 1 record)
+    void flush() {
+      if(!file) chunk.clear(), chunk_records = 0, prev_a = prev_b = 0;
+      if(!chunk_records) return;
+      unsigned char chunk_header[8];
+      put_fixed(chunk_header, chunk.size(), 4), put_fixed(chunk_header + 4, chunk_records, 4);
+      file.write(reinterpret_cast<const char*>(chunk_header), 8);
+      file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+      total_records += chunk_records, ++total_chunks, payload_bytes += chunk.size() + 8;
+      chunk.clear(), chunk_records = 0, prev_a = prev_b = 0;
+    }
+
+    // Flushes the last chunk & patches the header's totals
+    void close() {
+      if(!file.is_open()) return;
+      flush();
+      file.seekp(0);
+      write_header();
+      file.close();
+    }
+  };
+
+
+  // Streams every edge of "h" in rank order. Returns whether the file was written.
+  bool write_edge_list(const Hypercube &h, const std::string &path) {
+    binary_writer writer(path, EDGE_LIST, h.dimension);
+    if(!writer.good()) return false;
+    for(auto e : h.lazy_edges()) {
+      writer.write_edge(e);
+      if(!writer.good()) return false;
+    }
+    writer.close();
+    return writer.good();
+  }
+
+
+  // Streams every point's adjacency list of "h" (CSR row by row)
+  bool write_adjacency_csr(const Hypercube &h, const std::string &path) {
+    binary_writer writer(path, CSR_ADJACENCY, h.dimension);
+    if(!writer.good()) return false;
+    qnum adjacent[64];
+    for(qnum P = 0; P < h.total_points(); ++P) {
+      writer.write_adjacency(P, adjacent, adjacent + h.adjacent_points(P, adjacent));
+      if(!writer.good()) return false;
+    }
+    writer.close();
+    return writer.good();
+  }
+
+
+  // Streams every n-cube of "h" (generated on the fly, never materialized)
+  bool write_inner_cubes(const Hypercube &h, const qnum n, const std::string &path) {
+    binary_writer writer(path, SUBCUBE_LIST, h.dimension);
+    if(!writer.good()) return false;
+    if(n <= h.dimension)
+      for(qnum free_mask = 0; free_mask < h.total_points(); ++free_mask) {
+        if(qnum(__builtin_popcountll(free_mask)) != n) continue;
+        for(qnum base = 0; base < h.total_points(); base = ((base | free_mask) + 1) & ~free_mask) {
+          writer.write_subcube(subcube{free_mask, base});
+          if(!writer.good()) return false;
+          if((base | free_mask) + 1 == h.total_points()) break;
+        }
+      }
+    writer.close();
+    return writer.good();
+  }
+
+
+  // Streams the given subcubes (ie from "largest_inner_cubes_within")
+  bool write_subcubes(const subcubes &cubes, const qnum dimension, const std::string &path) {
+    binary_writer writer(path, SUBCUBE_LIST, dimension);
+    if(!writer.good()) return false;
+    for(auto cube : cubes) {
+      writer.write_subcube(cube);
+      if(!writer.good()) return false;
+    }
+    writer.close();
+    return writer.good();
+  }
+
+
+  // Memory-maps a file written by "binary_writer" & walks its records in place:
+  // nothing is copied out of the mapping beyond the record being decoded.
+  // (Falls back to reading the file into memory where mmap is unavailable.)
+  class binary_reader {
+    const unsigned char *bytes = nullptr;
+    qnum length = 0;
+    std::vector<unsigned char> fallback;
+    bool mapped = false, header_valid = false, valid = false;
+    binary_kinds file_kind = EDGE_LIST;
+    qnum file_dimension = 0, total_records = 0, total_chunks = 0;
+    // cursor
+    qnum offset = 32, chunk_end = 32, chunk_left = 0, prev_a = 0, prev_b = 0;
+
+    static qnum get_fixed(const unsigned char *src, const qnum n) {
+      qnum x = 0;
+      for(qnum i = n; i-- > 0;) x = (x << 8) | src[i];
+      return x;
+    }
+    qnum get_varint() {
+      qnum x = 0;
+      for(qnum shift = 0; offset < chunk_end; shift += 7) {
+        const unsigned char byte = bytes[offset++];
+        x |= qnum(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) break;
+      }
+      return x;
+    }
+    static qnum unzigzag(const qnum x) { return (x >> 1) ^ qnum(-std::int64_t(x & 1)); }
+    qnum get_neighbor(const qnum v) {
+      const qnum code = get_varint();
+      return (code & 1) ? v + unzigzag(code >> 1) : v ^ (qnum(1) << (code >> 1));
+    }
+    // Positions the cursor at the next record, entering the next chunk as needed
+    bool next_record() {
+      while(!chunk_left) {
+        if(!valid || chunk_end + 8 > length) return false;
+        offset = chunk_end + 8;
+        chunk_end = offset + get_fixed(bytes + offset - 8, 4);
+        chunk_left = get_fixed(bytes + offset - 4, 4);
+        prev_a = prev_b = 0;
+        if(chunk_end > length) { valid = false; return false; }
+      }
+      --chunk_left;
+      return true;
+    }
+
+  public:
+    explicit binary_reader(const std::string &path) {
+#ifdef QGRAPH_USE_MMAP
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      struct stat info;
+      if(fd >= 0 && !::fstat(fd, &info) && info.st_size > 0) {
+        void *map = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED) bytes = static_cast<const unsigned char*>(map), length = info.st_size, mapped = true;
+      }
+      if(fd >= 0) ::close(fd);
+#endif
+      if(!mapped) {
+        std::ifstream file(path, std::ios::binary);
+        fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bytes = fallback.data(), length = fallback.size();
+      }
+      valid = header_valid = length >= 32 && std::equal(bytes, bytes + 4, "QGRB") && bytes[4] == 1 && bytes[6] <= 64;
+      if(!valid) return;
+      file_kind      = binary_kinds(bytes[5]);
+      file_dimension = bytes[6];
+      total_records  = get_fixed(bytes + 8, 8);
+      total_chunks   = get_fixed(bytes + 16, 8);
+    }
+    binary_reader(const binary_reader &) = delete;
+    binary_reader &operator=(const binary_reader &) = delete;
+    ~binary_reader() {
+#ifdef QGRAPH_USE_MMAP
+      if(mapped) ::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    }
+
+    bool good()             const { return valid; }
+    binary_kinds kind()     const { return file_kind; }
+    qnum dimension()        const { return file_dimension; }
+    qnum records()          const { return total_records; }
+    qnum chunks()           const { return total_chunks; }
+    const unsigned char *data() const { return bytes; } // raw mapped file
+    qnum size()             const { return length; }
+
+    // Restarts the walk at the 1st record
+    void rewind() { offset = chunk_end = 32, chunk_left = 0, valid = header_valid; }
+
+
+    // Record walkers: each decodes the next record, returning false at the end
+    bool next_edge(qedge &e) {
+      if(file_kind != EDGE_LIST || !next_record()) return false;
+      e.first = prev_a += unzigzag(get_varint());
+      e.second = get_neighbor(e.first);
+      return true;
+    }
+    // "adjacent" is cleared & refilled, so reusing it across calls never reallocates
+    bool next_adjacency(qnum &P, qnums &adjacent) {
+      if(file_kind != CSR_ADJACENCY || !next_record()) return false;
+      P = prev_a += unzigzag(get_varint());
+      adjacent.resize(get_varint());
+      for(auto &point : adjacent) point = get_neighbor(P);
+      return true;
+    }
+    bool next_subcube(subcube &c) {
+      if(file_kind != SUBCUBE_LIST || !next_record()) return false;
+      c.free_mask = prev_a += unzigzag(get_varint());
+      c.base = prev_b += unzigzag(get_varint());
+      return true;
+    }
+  };
+
+  /******************************************************************************
+  * SHARED QUERY RESULT CACHE (OPT-IN, THREAD-SAFE, LRU BOUNDED BY BYTES)
+  ******************************************************************************/
+
+  struct query_cache_stats {
+    qnum hits = 0, misses = 0, evictions = 0;
+    qnum entries = 0, bytes = 0, byte_limit = 0;
+  };
+
+
+  // Memoizes "point_adjacency_matrix", "inner_cubes(n)" & "total_inner_cubes"
+  // by dimension, so every Hypercube of equal dimension shares 1 immutable copy.
+  // Matrices are handed out as shared_ptr<const qnum_matrix> views: an evicted
+  // result stays alive for as long as any caller still holds it. Results are
+  // computed outside the lock, so a slow miss never stalls other lookups (2
+  // threads missing the same key at once both compute it, & the 1st one wins).
+  // Results larger than the whole byte limit are returned but never stored.
+  struct query_cache {
+    using matrix_view = std::shared_ptr<const qnum_matrix>;
+
+    explicit query_cache(const qnum max_bytes = qnum(64) << 20) : byte_limit(max_bytes) {}
+    query_cache(const query_cache &) = delete;
+    query_cache &operator=(const query_cache &) = delete;
+
+
+    matrix_view point_adjacency_matrix(const Hypercube &h) {
+      return lookup_matrix(cache_key{ADJACENCY_MATRIX, h.dimension, 0}, [&]{ return h.point_adjacency_matrix(); });
+    }
+    matrix_view inner_cubes(const Hypercube &h, const qnum n) {
+      return lookup_matrix(cache_key{INNER_CUBES, h.dimension, n}, [&]{ return h.inner_cubes(n); });
+    }
+    qnum total_inner_cubes(const Hypercube &h, const qnum n) {
+      return lookup_count(cache_key{INNER_CUBE_COUNT, h.dimension, n}, [&]{ return h.total_inner_cubes(n); });
+    }
+    qnum total_inner_cubes(const Hypercube &h) {
+      return lookup_count(cache_key{ALL_INNER_CUBE_COUNT, h.dimension, 0}, [&]{ return h.total_inner_cubes(); });
+    }
+
+
+    query_cache_stats stats() const {
+      std::lock_guard<std::mutex> lock(mtx);
+      query_cache_stats s = counters;
+      s.entries = lru.size(), s.bytes = used_bytes, s.byte_limit = byte_limit;
+      return s;
+    }
+    void reset_stats() {
+      std::lock_guard<std::mutex> lock(mtx);
+      counters = query_cache_stats{};
+    }
+    // Evicts least-recently-used entries until the cache fits the new limit
+    void set_byte_limit(const qnum max_bytes) {
+      std::lock_guard<std::mutex> lock(mtx);
+      byte_limit = max_bytes;
+      evict_to_fit(0);
+    }
+    void clear() {
+      std::lock_guard<std::mutex> lock(mtx);
+      index.clear(), lru.clear(), used_bytes = 0;
+    }
+
+  private:
+    enum query_kinds {ADJACENCY_MATRIX, INNER_CUBES, INNER_CUBE_COUNT, ALL_INNER_CUBE_COUNT};
+    struct cache_key {
+      query_kinds kind; qnum dimension, n;
+      bool operator<(const cache_key &k) const {
+        return (kind != k.kind) ? kind < k.kind : (dimension != k.dimension) ? dimension < k.dimension : n < k.n;
+      }
+    };
+    struct cache_entry { cache_key key; matrix_view matrix; qnum count; qnum bytes; };
+
+    mutable std::mutex mtx;
+    std::list<cache_entry> lru; // most recently used at the front
+    std::map<cache_key, std::list<cache_entry>::iterator> index;
+    query_cache_stats counters;
+    qnum used_bytes = 0, byte_limit;
+
+    static qnum matrix_bytes(const qnum_matrix &m) {
+      qnum bytes = sizeof(qnum_matrix) + m.capacity() * sizeof(qnums);
+      for(auto &row : m) bytes += row.capacity() * sizeof(qnum);
+      return bytes;
+    }
+
+    // Returns the entry for "key" (promoting it to most-recently-used), else null
+    const cache_entry *find(const cache_key &key) {
+      auto it = index.find(key);
+      if(it == index.end()) { ++counters.misses; return nullptr; }
+      ++counters.hits;
+      lru.splice(lru.begin(), lru, it->second);
+      return &*it->second;
+    }
+    // Drops LRU entries until "incoming" more bytes fit w/in the limit
+    void evict_to_fit(const qnum incoming) {
+      while(!lru.empty() && used_bytes + incoming > byte_limit) {
+        used_bytes -= lru.back().bytes;
+        index.erase(lru.back().key);
+        lru.pop_back();
+        ++counters.evictions;
+      }
+    }
+    // Stores "entry" unless another thread beat us to it (returning the winner),
+    // or unless it can never fit (returning null)
+    const cache_entry *store(cache_entry &&entry) {
+      auto it = index.find(entry.key);
+      if(it != index.end()) return &*it->second;
+      if(entry.bytes > byte_limit) return nullptr;
+      evict_to_fit(entry.bytes);
+      used_bytes += entry.bytes;
+      lru.push_front(std::move(entry));
+      index[lru.front().key] = lru.begin();
+      return &lru.front();
+    }
+
+    template<typename Compute>
+    matrix_view lookup_matrix(const cache_key &key, Compute compute) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(const cache_entry *hit = find(key)) return hit->matrix;
+      }
+      matrix_view result = std::make_shared<const qnum_matrix>(compute());
+      const qnum bytes = matrix_bytes(*result);
+      std::lock_guard<std::mutex> lock(mtx);
+      const cache_entry *stored = store(cache_entry{key, result, 0, bytes});
+      return stored ? stored->matrix : result;
+    }
+    template<typename Compute>
+    qnum lookup_count(const cache_key &key, Compute compute) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(const cache_entry *hit = find(key)) return hit->count;
+      }
+      const qnum count = compute();
+      std::lock_guard<std::mutex> lock(mtx);
+      const cache_entry *stored = store(cache_entry{key, nullptr, count, sizeof(cache_entry)});
+      return stored ? stored->count : count;
+    }
+  };
+
+
+  // Process-wide cache for callers that don't want to own one
+  inline query_cache &shared_query_cache() {
+    static query_cache cache;
+    return cache;
+  }
+
+
+  /******************************************************************************
+  * MESH, RING, & TREE EMBEDDINGS (GUEST NODE i => HOST POINT mapping[i])
+  ******************************************************************************/
+
+  // Guest topologies as edge lists over their node indices:
+  // => meshes index nodes row-major (last axis varies fastest)
+  // => trees index nodes in 0-based heap order (node i's children are 2i+1 & 2i+2)
+  // => double-rooted trees are trees of 2^height - 1 nodes whose root-to-node-2
+  //    edge is subdivided by an extra 2nd root, indexed last (2^height - 1)
+  qedges mesh_edges(const qnums &sizes) {
+    qedges guest_edges;
+    qnum total = 1;
+    for(auto size : sizes) total *= size;
+    if(sizes.empty() || !total) return guest_edges;
+    for(qnum node = 0; node < total; ++node) {
+      qnum stride = 1;
+      for(qnum axis = sizes.size(); axis-- > 0; stride *= sizes[axis])
+        if((node / stride) % sizes[axis] + 1 < sizes[axis]) guest_edges.emplace_back(node, node + stride);
+    }
+    return guest_edges;
+  }
+  qedges ring_edges(const qnum length) {
+    qedges guest_edges;
+    for(qnum node = 0; length > 2 && node < length; ++node)
+      guest_edges.emplace_back(node, (node + 1) % length);
+    if(length == 2) guest_edges.emplace_back(0, 1);
+    return guest_edges;
+  }
+  qedges tree_edges(const qnum height) {
+    qedges guest_edges;
+    if(!height || height >= 64) return guest_edges;
+    for(qnum child = 1; child + 1 < (qnum(1) << height); ++child)
+      guest_edges.emplace_back((child - 1) / 2, child);
+    return guest_edges;
+  }
+  qedges double_rooted_tree_edges(const qnum height) {
+    qedges guest_edges = tree_edges(height);
+    if(height < 2) return guest_edges;
+    const qnum second_root = (qnum(1) << height) - 1;
+    guest_edges[1] = qedge(0, second_root); // replaces the (0,2) edge w/ 0-second_root-2
+    guest_edges.emplace_back(2, second_root);
+    return guest_edges;
+  }
+
+
+  // Gray-code mesh embedding: axis i gets ceil(log2(sizes[i])) bits & places
+  // coordinate x at gray(x) = x ^ (x >> 1), so mesh neighbors are cube neighbors
+  // (dilation 1). Returns empty if the mesh needs more bits than 'dimension'.
+  qnums gray_code_mesh_embedding(const Hypercube &h, const qnums &sizes) {
+    qnums bits(sizes.size());
+    qnum total = 1, total_bits = 0;
+    for(qnum axis = 0; axis < sizes.size(); ++axis) {
+      if(!sizes[axis]) return qnums{};
+      while((qnum(1) << bits[axis]) < sizes[axis]) ++bits[axis];
+      total *= sizes[axis], total_bits += bits[axis];
+    }
+    if(sizes.empty() || total_bits > h.dimension) return qnums{};
+    qnums mapping(total);
+    for(qnum node = 0; node < total; ++node) {
+      qnum label = 0, rest = node, shift = 0;
+      for(qnum axis = sizes.size(); axis-- > 0; shift += bits[axis]) {
+        const qnum x = rest % sizes[axis];
+        label |= (x ^ (x >> 1)) << shift;
+        rest /= sizes[axis];
+      }
+      mapping[node] = label;
+    }
+    return mapping;
+  }
+
+
+  // Ring embedding: a ring of even length 2m runs up the 1st m gray codes of the
+  // lower N-1 bits & back down them w/ the top bit set, so it's a cycle of cube
+  // edges (a Hamiltonian cycle when 2m = 2^N). Odd rings skip the final point, 
+  // so only their closing edge has dilation 2. Returns empty if length > 2^N.
+  qnums ring_embedding(const Hypercube &h, const qnum length) {
+    if(!length || !h.dimension || length > h.total_points()) return (length == 1) ? qnums{0} : qnums{};
+    const qnum half = (length + 1) / 2, top = qnum(1) << (h.dimension - 1);
+    qnums mapping(length);
+    for(qnum i = 0; i < length; ++i) {
+      const qnum x = (i < half) ? i : 2 * half - 1 - i;
+      mapping[i] = (x ^ (x >> 1)) | ((i < half) ? 0 : top);
+    }
+    return mapping;
+  }
+
+
+  // Inorder tree embedding: the complete binary tree of 2^height - 1 nodes is 
+  // labeled by its inorder #'s 1..2^height-1, so each right child is 1 cube edge
+  // from its parent & each left child 2 (dilation 2). Needs height <= dimension.
+  qnums inorder_tree_embedding(const Hypercube &h, const qnum height) {
+    if(!height || height > h.dimension || height >= 64) return qnums{};
+    qnums mapping((qnum(1) << height) - 1);
+    for(qnum node = 0; node < mapping.size(); ++node) {
+      const qnum depth = 63 - qnum(__builtin_clzll(node + 1)), position = node + 1 - (qnum(1) << depth);
+      mapping[node] = (2 * position + 1) << (height - 1 - depth);
+    }
+    return mapping;
+  }
+
+
+  // Double-rooted tree embedding (dilation 1, spanning Q_height): built up from
+  // DT_2 = the path x-a-b-y. Given DT_n w/ roots a & b (& b's child y), DT_n+1 
+  // takes DT_n in the top-bit-0 subcube & its image under the automorphism 
+  // swapping a & y while fixing b in the top-bit-1 subcube (copy 1). The new
+  // roots are b & b', their children a & a', then a gets x's & y''s subtrees & 
+  // a' gets x''s & y's. Needs 2 <= height <= dimension.
+  qnums double_rooted_tree_embedding(const Hypercube &h, const qnum height) {
+    if(height < 2 || height > h.dimension || height >= 64) return qnums{};
+    // labels[0] = 2nd root b, labels[k] = 1-based heap node k (a = 1, x = 2, y = 3)
+    qnums labels = {3, 1, 0, 2}, next;
+    for(qnum n = 2; n < height; ++n) {
+      const qnum b = labels[0], e1 = labels[1] ^ b, e2 = labels[3] ^ b, top = qnum(1) << n;
+      auto image = [&](const qnum v) { // b ^ (v ^ b w/ bits e1 & e2 swapped), in copy 1
+        const qnum w = v ^ b, swapped = (w & (e1 | e2)) && (w & (e1 | e2)) != (e1 | e2) ? w ^ (e1 | e2) : w;
+        return (b ^ swapped) | top;
+      };
+      next.assign(qnum(2) << n, 0);
+      next[0] = b | top, next[1] = b, next[2] = labels[1], next[3] = image(labels[1]);
+      for(qnum k = 2; k < labels.size(); ++k) { // k's subtree root is 2 (x) or 3 (y)
+        const qnum depth = 62 - qnum(__builtin_clzll(k)), root = k >> depth, offset = k - (root << depth);
+        next[((root == 2 ? 4 : 7) << depth) + offset] = labels[k];
+        next[((root == 2 ? 6 : 5) << depth) + offset] = image(labels[k]);
+      }
+      labels.swap(next);
+    }
+    qnums mapping(labels.size());
+    for(qnum k = 1; k < labels.size(); ++k) mapping[k-1] = labels[k];
+    mapping.back() = labels[0];
+    return mapping;
+  }
+
+
+  // Quality of a guest graph embedding. Each guest edge is routed along the same
+  // shortest path "shortest_path" takes (flipping higher bits first).
+  struct embedding_metrics {
+    bool valid = false;          // false if a mapping or guest edge was out of range
+    qnum guest_nodes = 0, guest_edges = 0;
+    qnum load = 0;               // most guest nodes mapped to 1 host point
+    double expansion = 0;        // total_points() / guest_nodes
+    qnum dilation = 0;           // longest guest edge, in cube edges
+    double average_dilation = 0;
+    qnum congestion = 0;         // most guest edges routed through 1 cube edge
+  };
+
+
+  // Evaluates any user-supplied embedding in parallel ("threads = 0" uses all
+  // hardware threads). Holds 1 32-bit counter per point for the load (64MB at
+  // 2^24 points), & tallies congestion 1 cube dimension at a time in the 1st
+  // 2^(N-1) of those same counters, so it never needs a counter per edge.
+  embedding_metrics evaluate_embedding(const Hypercube &h, const qnums &mapping, const qedges &guest_edges, 
+                                       qnum threads = 0) {
+    embedding_metrics metrics;
+    if(!h.dimension || h.dimension > 32 || mapping.empty()) return metrics;
+    if(!threads) threads = std::thread::hardware_concurrency();
+    if(!threads) threads = 1;
+    const qnum n = h.total_points(), m = guest_edges.size();
+    metrics.guest_nodes = mapping.size(), metrics.guest_edges = m;
+    metrics.expansion = double(n) / mapping.size();
+
+    // load
+    std::atomic<bool> in_range(true);
+    std::unique_ptr<std::atomic<std::uint32_t>[]> counts(new std::atomic<std::uint32_t>[n]);
+    parallel_for_ranges(n, threads, [&](qnum lo, qnum hi, qnum) {
+      for(qnum p = lo; p < hi; ++p) counts[p].store(0, std::memory_order_relaxed);
+    });
+    parallel_for_ranges(mapping.size(), threads, [&](qnum lo, qnum hi, qnum) {
+      for(qnum i = lo; i < hi; ++i)
+        if(mapping[i] < n) counts[mapping[i]].fetch_add(1, std::memory_order_relaxed);
+        else in_range = false;
+    });
+    qnums thread_max(threads), thread_sum(threads);
+    parallel_for_ranges(n, threads, [&](qnum lo, qnum hi, qnum t) {
+      for(qnum p = lo; p < hi; ++p) thread_max[t] = std::max(thread_max[t], qnum(counts[p].load(std::memory_order_relaxed)));
+    });
+    metrics.load = *std::max_element(thread_max.begin(), thread_max.end());
+
+    // dilation
+    std::fill(thread_max.begin(), thread_max.end(), 0);
+    parallel_for_ranges(m, threads, [&](qnum lo, qnum hi, qnum t) {
+      for(qnum i = lo; i < hi; ++i) {
+        if(guest_edges[i].first >= mapping.size() || guest_edges[i].second >= mapping.size()) { in_range = false; continue; }
+        const qnum length = __builtin_popcountll(mapping[guest_edges[i].first] ^ mapping[guest_edges[i].second]);
+        thread_max[t] = std::max(thread_max[t], length), thread_sum[t] += length;
+      }
+    });
+    if(!in_range) return embedding_metrics{};
+    metrics.dilation = *std::max_element(thread_max.begin(), thread_max.end());
+    qnum total_length = 0;
+    for(auto sum : thread_sum) total_length += sum;
+    metrics.average_dilation = m ? double(total_length) / m : 0;
+
+    // congestion: a path from a to b crosses dimension d (iff they differ there)
+    // at the point w/ b's bits above d & a's bits at & below d
+    const qnum half = n / 2;
+    std::fill(thread_max.begin(), thread_max.end(), 0);
+    for(qnum d = 0; d < h.dimension; ++d) {
+      parallel_for_ranges(half, threads, [&](qnum lo, qnum hi, qnum) {
+        for(qnum i = lo; i < hi; ++i) counts[i].store(0, std::memory_order_relaxed);
+      });
+      const qnum low_bits = (qnum(2) << d) - 1;
+      parallel_for_ranges(m, threads, [&](qnum lo, qnum hi, qnum) {
+        for(qnum i = lo; i < hi; ++i) {
+          const qnum a = mapping[guest_edges[i].first], b = mapping[guest_edges[i].second];
+          if(!(((a ^ b) >> d) & 1)) continue;
+          const qnum crossing = (b & ~low_bits) | (a & low_bits);
+          counts[remove_bit(crossing, d)].fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+      parallel_for_ranges(half, threads, [&](qnum lo, qnum hi, qnum t) {
+        for(qnum i = lo; i < hi; ++i) thread_max[t] = std::max(thread_max[t], qnum(counts[i].load(std::memory_order_relaxed)));
+      });
+    }
+    metrics.congestion = *std::max_element(thread_max.begin(), thread_max.end());
+    metrics.valid = true;
+    return metrics;
+  }
+
+
+  /******************************************************************************
+  * BITSET BFS & DISTANCE DISTRIBUTIONS OVER INDUCED SUBGRAPHS
+  ******************************************************************************/
+
+  // All-pairs distance summary of an induced subgraph
+  struct distance_distribution {
+    qnums histogram;          // [d] = # of unordered pairs of members at distance d (d >= 1)
+    qnums eccentricities;     // per member in ascending point order (over the members it reaches)
+    qnum diameter = 0;        // greatest finite distance
+    qnum disconnected_pairs = 0;
+    double average_distance = 0; // over connected pairs
+  };
+
+
+  // Subgraph of a Hypercube induced by a subset of its points, held as a bitmap
+  // (bit p of word p/64). Adjacency is implicit (flip 1 bit, keep it if it's a
+  // member), so no 2^N adjacency lists are ever built.
+  struct induced_subgraph {
+    static constexpr std::uint32_t unreachable = 0xffffffffu;
+    qnum dimension = 0;
+    qnums members; // bitmap
+
+    induced_subgraph() = default;
+    // Points outside the Hypercube are ignored (dimension must be <= 32)
+    induced_subgraph(const Hypercube &h, const qnums &points) : dimension(h.dimension) {
+      if(dimension > 32) { dimension = 0; return; }
+      members.assign(word_count(), 0);
+      for(auto point : points) 
+        if(point < total_points()) members[point / 64] |= qnum(1) << (point % 64);
+    }
+
+    qnum total_points() const { return qnum(1) << dimension; }
+    bool contains(const qnum point) const { 
+      return point < total_points() && ((members[point / 64] >> (point % 64)) & 1); 
+    }
+    qnum size() const {
+      qnum total = 0;
+      for(auto word : members) total += __builtin_popcountll(word);
+      return total;
+    }
+    qnums points() const {
+      qnums member_points;
+      member_points.reserve(size());
+      for(qnum i = 0; i < members.size(); ++i)
+        for(qnum word = members[i]; word; word &= word - 1)
+          member_points.push_back(64 * i + __builtin_ctzll(word));
+      return member_points;
+    }
+
+
+    // Direction-optimizing BFS: sparse frontiers expand top-down from a vertex
+    // list, while dense ones (|frontier| * 14 > |unvisited|) switch to bottom-up,
+    // where every word of unvisited members checks all N neighbor words of the 
+    // frontier bitmap at once. Returns each point's distance from "source" 
+    // ("unreachable" for non-members & unreached points), or empty if "source"
+    // isn't a member.
+    std::vector<std::uint32_t> distances(const qnum source) const {
+      if(!contains(source)) return std::vector<std::uint32_t>{};
+      std::vector<std::uint32_t> dist(total_points(), unreachable);
+      qnums unvisited = members, frontier_bits(members.size(), 0), next_bits(members.size(), 0);
+      qnums frontier = {source}, next;
+      qnum unvisited_count = size() - 1;
+      unvisited[source / 64] ^= qnum(1) << (source % 64);
+      frontier_bits[source / 64] |= qnum(1) << (source % 64);
+      dist[source] = 0;
+
+      for(std::uint32_t level = 1; !frontier.empty(); ++level) {
+        next.clear();
+        if(frontier.size() * 14 > unvisited_count) { // bottom-up
+          for(qnum i = 0; i < members.size(); ++i) {
+            if(!unvisited[i]) continue;
+            qnum reached = 0;
+            for(qnum d = 0; d < dimension; ++d) reached |= neighbor_word(frontier_bits, i, d);
+            const qnum found = reached & unvisited[i];
+            unvisited[i] ^= found, next_bits[i] = found;
+            for(qnum word = found; word; word &= word - 1) {
+              const qnum point = 64 * i + __builtin_ctzll(word);
+              dist[point] = level, next.push_back(point);
+            }
+          }
+        } else { // top-down
+          for(auto point : frontier)
+            for(qnum d = 0; d < dimension; ++d) {
+              const qnum neighbor = point ^ (qnum(1) << d), bit = qnum(1) << (neighbor % 64);
+              if(!(unvisited[neighbor / 64] & bit)) continue;
+              unvisited[neighbor / 64] ^= bit, next_bits[neighbor / 64] |= bit;
+              dist[neighbor] = level, next.push_back(neighbor);
+            }
+        }
+        for(auto point : frontier) frontier_bits[point / 64] = 0;
+        frontier_bits.swap(next_bits), frontier.swap(next);
+        unvisited_count -= frontier.size();
+      }
+      return dist;
+    }
+
+
+    // Greatest distance from "source" to any member it reaches
+    qnum eccentricity(const qnum source) const {
+      qnum ecc = 0;
+      for(auto d : distances(source)) if(d != unreachable) ecc = std::max(ecc, qnum(d));
+      return ecc;
+    }
+
+
+    // All-pairs distances by bit-parallel BFS: 64 sources run at once, each 
+    // point holding a 64-bit mask of the sources that have reached it, so 1 
+    // level of all 64 searches is 1 pass of N word-ORs per member. Batches of 
+    // sources are spread over "threads" (0 => all hardware threads, capped at 
+    // the # of batches). Each thread holds 3 masks per slot: slots are points
+    // when members fill >= 1/4 of the cube, else member ranks (w/ neighbors
+    // found via the member bitmap & 1 shared prefix count per bitmap word), so
+    // memory grows w/ the # of members rather than w/ 2^N.
+    distance_distribution all_pairs_distances(qnum threads = 0) const {
+      distance_distribution result;
+      const qnums pts = points();
+      const qnum k = pts.size(), batches = (k + 63) / 64;
+      if(!k) return result;
+      if(!threads) threads = std::thread::hardware_concurrency();
+      if(!threads) threads = 1;
+      threads = std::min(threads, batches);
+      result.eccentricities.assign(k, 0);
+      std::vector<qnums> thread_histograms(threads);
+      std::atomic<qnum> next_batch(0);
+
+      const bool by_point = total_points() <= 4 * k;
+      const qnum slots = by_point ? total_points() : k;
+      // word_ranks[i] = # of members in words [0,i), so a member's rank (ie its
+      // index in "pts") is that plus the # of members below it in its word
+      qnums word_ranks;
+      if(!by_point) {
+        word_ranks.assign(members.size(), 0);
+        for(qnum i = 1; i < members.size(); ++i) word_ranks[i] = word_ranks[i-1] + __builtin_popcountll(members[i-1]);
+      }
+
+      // "neighbor_mask(masks, point)" returns the mask of a neighboring point
+      // (0 for non-members)
+      auto run_batches = [&](auto neighbor_mask) {
+        parallel_for_ranges(threads, threads, [&](qnum, qnum, qnum t) {
+          qnums &histogram = thread_histograms[t];
+          qnums visited(slots), frontier(slots), next(slots);
+          for(qnum batch; (batch = next_batch++) < batches;) {
+            const qnum first = 64 * batch, count = std::min(qnum(64), k - first);
+            std::fill(visited.begin(), visited.end(), 0), std::fill(frontier.begin(), frontier.end(), 0);
+            for(qnum s = 0; s < count; ++s) {
+              const qnum slot = by_point ? pts[first + s] : first + s;
+              visited[slot] = frontier[slot] = qnum(1) << s;
+            }
+            for(qnum level = 1;; ++level) {
+              qnum reached_any = 0, pairs = 0;
+              for(qnum r = 0; r < k; ++r) {
+                const qnum slot = by_point ? pts[r] : r;
+                qnum reached = 0;
+                for(qnum d = 0; d < dimension; ++d) reached |= neighbor_mask(frontier, pts[r] ^ (qnum(1) << d));
+                reached &= ~visited[slot];
+                next[slot] = reached, visited[slot] |= reached;
+                reached_any |= reached, pairs += __builtin_popcountll(reached);
+              }
+              if(!reached_any) break;
+              if(histogram.size() <= level) histogram.resize(level + 1, 0);
+              histogram[level] += pairs;
+              for(qnum word = reached_any; word; word &= word - 1)
+                result.eccentricities[first + __builtin_ctzll(word)] = level;
+              frontier.swap(next);
+            }
+          }
+        });
+      };
+      if(by_point) {
+        run_batches([](const qnums &masks, const qnum point) { return masks[point]; });
+      } else {
+        run_batches([&](const qnums &masks, const qnum point) {
+          const qnum word = members[point / 64], bit = point % 64;
+          return ((word >> bit) & 1) ? masks[word_ranks[point / 64] + __builtin_popcountll(word & ((qnum(1) << bit) - 1))] : 0;
+        });
+      }
+
+      // merge ordered pair counts into unordered ones
+      qnum connected_pairs = 0, total_distance = 0;
+      for(auto &histogram : thread_histograms) {
+        if(result.histogram.size() < histogram.size()) result.histogram.resize(histogram.size(), 0);
+        for(qnum d = 0; d < histogram.size(); ++d) result.histogram[d] += histogram[d];
+      }
+      for(qnum d = 1; d < result.histogram.size(); ++d) {
+        result.histogram[d] /= 2;
+        connected_pairs += result.histogram[d], total_distance += d * result.histogram[d];
+        if(result.histogram[d]) result.diameter = d;
+      }
+      result.disconnected_pairs = k * (k - 1) / 2 - connected_pairs;
+      result.average_distance = connected_pairs ? double(total_distance) / connected_pairs : 0;
+      return result;
+    }
+
+  private:
+    qnum word_count() const { return (total_points() + 63) / 64; }
+
+    // Word "i" of "bits" w/ every point's bit replaced by that of its neighbor
+    // across dimension "d": whole words swap for d >= 6, else bits swap in-word
+    static qnum neighbor_word(const qnums &bits, const qnum i, const qnum d) {
+      static const qnum low_halves[6] = {0x5555555555555555ULL, 0x3333333333333333ULL, 0x0f0f0f0f0f0f0f0fULL,
+                                         0x00ff00ff00ff00ffULL, 0x0000ffff0000ffffULL, 0x00000000ffffffffULL};
+      if(d >= 6) return bits[i ^ (qnum(1) << (d - 6))];
+      const qnum x = bits[i], shift = qnum(1) << d;
+      return ((x & low_halves[d]) << shift) | ((x >> shift) & low_halves[d]);
+    }
+  };
 };
 #endif
@@ -0,0 +1,352 @@
+// Author: Jordan Randleman -- qgraph_Benchmark.cpp -- "qgraph.hpp" Benchmark Suite
+
+// Times every public Hypercube method, all 4 shortest_path overloads, &
+// induced_subgraph's BFS queries across dimensions 1..N, recording the min &
+// median wall time of repeated runs (after 1 untimed warm-up), heap
+// allocations, & peak RSS, then writes the results as JSON to track scaling
+// regressions across releases.
+//
+// BUILD: g++ -std=c++17 -O2 -pthread qgraph_Benchmark.cpp -o qgraph_Benchmark
+// RUN:   ./qgraph_Benchmark [max_dimension = 16] [output_path = qgraph_benchmark.json] [budget_seconds = 2] [repetitions = 5]
+//
+// Once a method's median run exceeds the per-run budget, its larger dimensions
+// are skipped (ie "inner_cubes" stops scaling long before "adjacent_points").
+// A warm-up that alone exceeds the budget is reported as that method's only run.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "qgraph.hpp"
+
+/******************************************************************************
+* ALLOCATION COUNTING (REPLACES THE GLOBAL ALLOCATION FUNCTIONS)
+******************************************************************************/
+
+static std::atomic<unsigned long long> allocation_count(0), allocation_bytes(0);
+
+// GCC flags malloc/free w/in replaced new/delete as "mismatched" once inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t bytes) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  if(void *p = std::malloc(bytes ? bytes : 1)) return p;
+  throw std::bad_alloc();
+}
+void *operator new[](std::size_t bytes) { return operator new(bytes); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+/******************************************************************************
+* PEAK RESIDENT SET SIZE
+******************************************************************************/
+
+// Resets the kernel's peak RSS watermark where supported (Linux >= 4.0), so
+// each benchmark's peak is its own rather than the process's all-time peak
+static void reset_peak_rss() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if(clear_refs) clear_refs << "5";
+}
+
+// Returns peak RSS in KiB: "VmHWM" on Linux, else getrusage's all-time peak
+static unsigned long long peak_rss_kb() {
+  std::ifstream status("/proc/self/status");
+  for(std::string line; std::getline(status, line);)
+    if(line.compare(0, 6, "VmHWM:") == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if(!getrusage(RUSAGE_SELF, &usage))
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;        // KiB elsewhere
+#endif
+#endif
+  return 0;
+}
+
+/******************************************************************************
+* BENCHMARK HARNESS
+******************************************************************************/
+
+struct bench_result {
+  std::string method;
+  unsigned long long dimension, calls, repetitions, min_wall_ns, median_wall_ns, allocations, allocated_bytes, peak_rss_kb;
+};
+
+static volatile unsigned long long sink = 0; // keeps results observable
+
+// Folds "x" into "sink" via a plain load & store (compound assignment to a
+// volatile is deprecated as of C++20)
+static void keep(const unsigned long long x) { sink = sink + x; }
+
+
+// Runs "fcn" once & records its wall time, allocations, & peak RSS (as a
+// 1-repetition result w/o its method, dimension, or call count)
+static bench_result time_run(const std::function<void()> &fcn) {
+  reset_peak_rss();
+  const unsigned long long allocs_before = allocation_count.load(), bytes_before = allocation_bytes.load();
+  const auto start = std::chrono::steady_clock::now();
+  fcn();
+  const auto stop = std::chrono::steady_clock::now();
+  const unsigned long long allocs = allocation_count.load() - allocs_before, bytes = allocation_bytes.load() - bytes_before;
+  const unsigned long long wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  return bench_result{std::string(), 0, 0, 1, wall_ns, wall_ns, allocs, bytes, peak_rss_kb()};
+}
+
+
+// Runs "fcn" (which performs "calls" method calls) once untimed to warm caches
+// & the allocator, then "repetitions" timed times, recording the min & median
+// wall times, the 1st timed run's allocations, & the greatest peak RSS
+static bench_result run_bench(const std::string &method, const unsigned long long dimension,
+                              const unsigned long long calls, const unsigned long long repetitions,
+                              const unsigned long long budget_ns, const std::function<void()> &fcn) {
+  bench_result result = time_run(fcn);
+  if(result.min_wall_ns <= budget_ns && repetitions) {
+    std::vector<unsigned long long> wall_times;
+    wall_times.reserve(repetitions);
+    for(unsigned long long i = 0; i < repetitions; ++i) {
+      const bench_result run = time_run(fcn);
+      if(!i) result.allocations = run.allocations, result.allocated_bytes = run.allocated_bytes, result.peak_rss_kb = 0;
+      result.peak_rss_kb = std::max(result.peak_rss_kb, run.peak_rss_kb);
+      wall_times.push_back(run.min_wall_ns);
+    }
+    std::sort(wall_times.begin(), wall_times.end());
+    const std::size_t mid = wall_times.size() / 2;
+    result.repetitions = repetitions;
+    result.min_wall_ns = wall_times.front();
+    result.median_wall_ns = (wall_times.size() % 2) ? wall_times[mid] : (wall_times[mid - 1] + wall_times[mid]) / 2;
+  }
+  result.method = method, result.dimension = dimension, result.calls = calls;
+  return result;
+}
+
+
+static void write_json(const std::vector<bench_result> &results, const unsigned long long max_dimension, const std::string &path) {
+  std::ofstream out(path);
+  out << "{\n  \"benchmark\": \"qgraph\",\n  \"max_dimension\": " << max_dimension << ",\n  \"results\": [\n";
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    const bench_result &r = results[i];
+    out << "    {\"method\": \"" << r.method << "\", \"dimension\": " << r.dimension
+        << ", \"calls\": " << r.calls << ", \"repetitions\": " << r.repetitions
+        << ", \"min_wall_ns\": " << r.min_wall_ns << ", \"median_wall_ns\": " << r.median_wall_ns
+        << ", \"ns_per_call\": " << (r.calls ? double(r.median_wall_ns) / double(r.calls) : 0.0)
+        << ", \"allocations\": " << r.allocations << ", \"allocated_bytes\": " << r.allocated_bytes
+        << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+/******************************************************************************
+* MAIN EXECUTION
+******************************************************************************/
+
+int main(int argc, char *argv[]) {
+  using namespace qgraph;
+
+  const qnum max_dimension = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 16;
+  const std::string output_path = (argc > 2) ? argv[2] : "qgraph_benchmark.json";
+  const double budget_seconds = (argc > 3) ? std::strtod(argv[3], nullptr) : 2.0;
+  const unsigned long long budget_ns = (unsigned long long)(budget_seconds * 1e9);
+  const unsigned long long repetitions = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 5;
+
+  // Per-point methods are timed over up to this many points per dimension
+  const qnum max_point_calls = qnum(1) << 16;
+
+  // Each case maps a dimension to (# of calls, work performing those calls)
+  struct bench_case {
+    std::string method;
+    std::function<qnum(const Hypercube&)> calls;
+    std::function<void(const Hypercube&)> work;
+  };
+  auto point_calls = [=](const Hypercube &h) { return std::min(h.total_points(), max_point_calls); };
+  auto once = [](const Hypercube &) { return qnum(1); };
+  // All points but every 97th (ie a cube w/ scattered failures)
+  auto healthy_points = [](const Hypercube &h) {
+    qnums healthy;
+    for(qnum P = 0; P < h.total_points(); ++P) if(P % 97 != 1) healthy.push_back(P);
+    return healthy;
+  };
+
+  const std::vector<bench_case> cases = {
+    // NON-MEMBER FUNCTIONS
+    {"convert_coord_to_point(qnums)", point_calls, [&](const Hypercube &h) {
+      const qnums coord(h.dimension, 1);
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(convert_coord_to_point(coord));
+    }},
+    {"shortest_path(qnum,qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(shortest_path(P, h.total_points() - 1 - P).size());
+    }},
+    {"shortest_path(qnums,qnums)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P)
+        keep(shortest_path(h.convert_point_to_coord(P), h.convert_point_to_coord(h.total_points() - 1 - P)).size());
+    }},
+    {"shortest_path(qnum,qnum,OutputIt)", point_calls, [&](const Hypercube &h) {
+      qnum path[64];
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(shortest_path(P, h.total_points() - 1 - P, path));
+    }},
+    {"shortest_path(qnums,qnums,OutputIt)", point_calls, [&](const Hypercube &h) {
+      qnum coords[65 * 64];
+      for(qnum P = 0, n = point_calls(h); P < n; ++P)
+        keep(shortest_path(h.convert_point_to_coord(P), h.convert_point_to_coord(h.total_points() - 1 - P), coords));
+    }},
+
+    // HYPERCUBE MEMBERS
+    {"total_points()", point_calls, [&](const Hypercube &h) {
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.total_points());
+    }},
+    {"convert_point_to_coord(qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.convert_point_to_coord(P).size());
+    }},
+    {"convert_point_to_coord(qnum,OutputIt)", point_calls, [&](const Hypercube &h) {
+      qnum coord[64];
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.convert_point_to_coord(P, coord));
+    }},
+    {"adjacent_points(qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_points(P).size());
+    }},
+    {"adjacent_points(qnums)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_points(h.convert_point_to_coord(P)).size());
+    }},
+    {"adjacent_points(qnum,OutputIt)", point_calls, [&](const Hypercube &h) {
+      qnum adjacent[64];
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_points(P, adjacent));
+    }},
+    {"adjacent_coords(qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_coords(P).size());
+    }},
+    {"adjacent_coords(qnums)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_coords(h.convert_point_to_coord(P)).size());
+    }},
+    {"adjacent_coords(qnum,OutputIt)", point_calls, [&](const Hypercube &h) {
+      qnum coords[64 * 64];
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.adjacent_coords(P, coords));
+    }},
+    {"point_adjacency_matrix()", once, [&](const Hypercube &h) { keep(h.point_adjacency_matrix().size()); }},
+    {"coord_adjacency_matrix()", once, [&](const Hypercube &h) { keep(h.coord_adjacency_matrix().size()); }},
+    {"total_inner_cubes(qnum)", once, [&](const Hypercube &h) { keep(h.total_inner_cubes(h.dimension / 2)); }},
+    {"total_inner_cubes(Hypercube)", once, [&](const Hypercube &h) { keep(h.total_inner_cubes(Hypercube(h.dimension / 2))); }},
+    {"total_inner_cubes()", once, [&](const Hypercube &h) { keep(h.total_inner_cubes()); }},
+    {"inner_cubes(qnum)", once, [&](const Hypercube &h) { keep(h.inner_cubes(h.dimension / 2).size()); }},
+    {"inner_cubes(Hypercube)", once, [&](const Hypercube &h) { keep(h.inner_cubes(Hypercube(h.dimension / 2)).size()); }},
+    {"inner_cubes_coord(qnum)", once, [&](const Hypercube &h) { keep(h.inner_cubes_coord(h.dimension / 2).size()); }},
+    {"inner_cubes_coord(Hypercube)", once, [&](const Hypercube &h) { keep(h.inner_cubes_coord(Hypercube(h.dimension / 2)).size()); }},
+    {"subcube_points(subcube)", once, [&](const Hypercube &h) { keep(h.subcube_points(subcube{h.total_points() - 1, 0}).size()); }},
+    {"largest_inner_cubes_within(qnums)", once, [&](const Hypercube &h) {
+      keep(h.largest_inner_cubes_within(healthy_points(h)).size());
+    }},
+    {"maximal_inner_cubes_within(qnums)", once, [&](const Hypercube &h) {
+      keep(h.maximal_inner_cubes_within(healthy_points(h)).size());
+    }},
+    {"total_edges()", point_calls, [&](const Hypercube &h) {
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.total_edges());
+    }},
+    {"edge_rank(qnum,qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.edge_rank(P, P ^ 1));
+    }},
+    {"edge_rank(qedge)", point_calls, [&](const Hypercube &h) {
+      for(qnum P = 0, n = point_calls(h); P < n; ++P) keep(h.edge_rank(qedge(P & ~qnum(1), P | 1)));
+    }},
+    {"edge_unrank(qnum)", point_calls, [&](const Hypercube &h) {
+      for(qnum r = 0, n = point_calls(h); r < n; ++r) keep(h.edge_unrank(r).second);
+    }},
+    {"lazy_edges()", [](const Hypercube &h) { return h.total_edges(); }, [&](const Hypercube &h) {
+      for(auto e : h.lazy_edges()) keep(e.first);
+    }},
+    {"lazy_dimension_edges(qnum)", [](const Hypercube &h) { return h.total_points() / 2; }, [&](const Hypercube &h) {
+      for(auto e : h.lazy_dimension_edges(h.dimension - 1)) keep(e.first);
+    }},
+    {"edges()", once, [&](const Hypercube &h) { keep(h.edges().size()); }},
+    {"dimension_edges(qnum)", once, [&](const Hypercube &h) { keep(h.dimension_edges(h.dimension - 1).size()); }},
+
+
+    // UNIFORM RANDOM SAMPLING (n-CUBES OF HALF THE DIMENSION, PATHS ACROSS THE WHOLE CUBE)
+    {"sample_stride()", point_calls, [&](const Hypercube &h) {
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.sample_stride());
+    }},
+    {"random_point(counter_rng)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.random_point(rng));
+    }},
+    {"random_subcube(qnum,counter_rng)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.random_subcube(h.dimension / 2, rng).free_mask);
+    }},
+    {"random_shortest_path(qnum,qnum,counter_rng,OutputIt)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      qnum path[64];
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(path[h.random_shortest_path(0, h.total_points() - 1, rng, path) - 1]);
+    }},
+    {"random_shortest_path(qnum,qnum,counter_rng)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      for(qnum i = 0, n = point_calls(h); i < n; ++i) keep(h.random_shortest_path(0, h.total_points() - 1, rng).size());
+    }},
+    {"random_points(qnum,counter_rng,OutputIt)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      qnums points(point_calls(h));
+      h.random_points(points.size(), rng, points.begin());
+      keep(points.back());
+    }},
+    {"random_subcubes(qnum,qnum,counter_rng,OutputIt)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      subcubes cubes(point_calls(h));
+      h.random_subcubes(h.dimension / 2, cubes.size(), rng, cubes.begin());
+      keep(cubes.back().base);
+    }},
+    {"random_shortest_paths(qnum,qnum,qnum,counter_rng,OutputIt)", point_calls, [&](const Hypercube &h) {
+      counter_rng rng(1);
+      qnums paths(point_calls(h) * h.dimension);
+      h.random_shortest_paths(0, h.total_points() - 1, point_calls(h), rng, paths.begin());
+      keep(paths[paths.size() / 2]);
+    }},
+
+    // INDUCED SUBGRAPHS (EACH RUN ALSO BUILDS ITS SUBGRAPH, TIMED ALONE BY THE 1ST CASE)
+    {"induced_subgraph(Hypercube,qnums)", once, [&](const Hypercube &h) {
+      keep(induced_subgraph(h, healthy_points(h)).size());
+    }},
+    {"induced_subgraph::distances(qnum)", once, [&](const Hypercube &h) {
+      const induced_subgraph g(h, healthy_points(h));
+      keep(g.distances(0).size());
+    }},
+    {"induced_subgraph::eccentricity(qnum)", once, [&](const Hypercube &h) {
+      const induced_subgraph g(h, healthy_points(h));
+      keep(g.eccentricity(0));
+    }},
+    {"induced_subgraph::all_pairs_distances()", once, [&](const Hypercube &h) {
+      const induced_subgraph g(h, healthy_points(h));
+      keep(g.all_pairs_distances().diameter);
+    }},
+  };
+
+  std::vector<bench_result> results;
+  for(const bench_case &c : cases) {
+    for(qnum dimension = 1; dimension <= max_dimension; ++dimension) {
+      const Hypercube h(dimension);
+      const bench_result r = run_bench(c.method, dimension, c.calls(h), repetitions, budget_ns, [&]{ c.work(h); });
+      results.push_back(r);
+      std::cerr << c.method << " @ dimension " << dimension << ": " << r.median_wall_ns / 1e6 << " ms median ("
+                << r.min_wall_ns / 1e6 << " ms min of " << r.repetitions << "), "
+                << r.allocations << " allocations, peak RSS " << r.peak_rss_kb << " KiB\n";
+      if(r.median_wall_ns > budget_ns) break; // larger dimensions would only take longer
+    }
+  }
+
+  write_json(results, max_dimension, output_path);
+  std::cerr << "=> Wrote " << results.size() << " results to " << output_path << "\n";
+  return 0;
+}
@@ -7,20 +7,26 @@
 /* 
  * "qgraph.hpp" PUBLIC CONTENTS:
  *
- * TYPE ALIASES (4):
+ * TYPE ALIASES (8):
  *   (0) qnum         // NUMERIC (ie any point, total # of points, etc)
  *   (1) qnums        // NUMERIC VECTOR (ie coordinates, list of adjacent points, etc)
  *   (2) qnum_matrix  // NUMERIC VECTOR MATRIX (ie inner cubes, list of adjacent coords, etc)
  *   (3) coord_matrix // NUMERIC VECTOR 3D MATRIX (ie coord adjacency matrix, inner cubes in coords, etc)
+ *   (4) subcube      // COMPACT INNER CUBE (free-dimension bitmask & base point)
+ *   (5) subcubes     // COMPACT INNER CUBE VECTOR
+ *   (6) qedge        // EDGE AS (LOWER POINT, HIGHER POINT)
+ *   (7) qedges       // EDGE VECTOR
  *
  *
- * NON MEMBER FUNCTIONS (3):
+ * NON MEMBER FUNCTIONS (5):
  *   (0) qnum        convert_coord_to_point(qnums)  // converts coords to a point
  *   (1) qnums       shortest_path(qnum, qnum)      // returns shortest path btwn given pts
  *   (2) qnum_matrix shortest_path(qnums, qnums)    // returns shortest path's coords btwn given coords
+ *   (3) qnum        shortest_path(qnum, qnum, OutputIt)   // writes shortest path btwn given pts, returns its length
+ *   (4) qnum        shortest_path(qnums, qnums, OutputIt) // writes shortest path's flattened coords, returns its length
  * 
  *
- * MEMBERS OF Hypercube (19): 
+ * MEMBERS OF Hypercube (41): 
  *   (00) qnum dimension                            // member dictating Hypercube's dimension
  *   (01) qnum total_points()                       // returns total points in 'dimension'
  * 
@@ -44,6 +50,84 @@
  *   (16) qnum_matrix  inner_cubes(Hypercube)       // given Hypercube of dimension n, returns matrix of all n cubes' pts in 'dimension'
  *   (17) coord_matrix inner_cubes_coord(qnum)      // given dimension n, returns matrix of all n cubes' pt-coords in 'dimension'
  *   (18) coord_matrix inner_cubes_coord(Hypercube) // given Hypercube of dimension n, returns matrix of all n cubes' pt-coords in 'dimension'
+ *
+ *   (19) qnums    subcube_points(subcube)          // returns sorted points composing the given subcube
+ *   (20) subcubes largest_inner_cubes_within(qnums) // returns all greatest-dimension subcubes lying fully w/in the given points
+ *   (21) subcubes maximal_inner_cubes_within(qnums) // returns all subcubes w/in the given points not w/in a larger one
+ *
+ *   (22) qnum       total_edges()                  // returns total edges in 'dimension' (N * 2^(N-1))
+ *   (23) qnum       edge_rank(qnum, qnum)          // returns O(1) rank of the edge btwn 2 adjacent pts
+ *   (24) qnum       edge_rank(qedge)               // returns O(1) rank of the given edge
+ *   (25) qedge      edge_unrank(qnum)              // returns the edge w/ the given rank in O(1)
+ *   (26) edge_range lazy_edges()                   // returns lazy sequence of all edges in rank order
+ *   (27) edge_range lazy_dimension_edges(qnum)     // returns lazy sequence of the edges along the given dimension
+ *   (28) qedges     edges()                        // returns vector of all edges in rank order
+ *   (29) qedges     dimension_edges(qnum)          // returns vector of the edges along the given dimension
+ *
+ *   (30) qnum convert_point_to_coord(qnum, OutputIt) // writes point's coords, returns # written
+ *   (31) qnum adjacent_points(qnum, OutputIt)        // writes sorted pts adjacent to given pt, returns # written
+ *   (32) qnum adjacent_coords(qnum, OutputIt)        // writes flattened coords of adjacent pts, returns # of pts
+ *
+ *   (33) qnum    sample_stride()                   // # of rng counters each sample consumes (dimension + 1)
+ *   (34) qnum    random_point(counter_rng)         // returns a uniformly random point
+ *   (35) subcube random_subcube(qnum, counter_rng) // returns a uniformly random n-cube
+ *   (36) qnum    random_shortest_path(qnum, qnum, counter_rng, OutputIt) // writes a uniformly random shortest path
+ *   (37) qnums   random_shortest_path(qnum, qnum, counter_rng)           // returns a uniformly random shortest path
+ *   (38) qnum    random_points(qnum, counter_rng, OutputIt)              // writes a batch of random points
+ *   (39) qnum    random_subcubes(qnum, qnum, counter_rng, OutputIt)      // writes a batch of random n-cubes
+ *   (40) qnum    random_shortest_paths(qnum, qnum, qnum, counter_rng, OutputIt) // writes a batch of random shortest paths
+ *
+ *
+ * EDGE-INDEXED TYPES (2):
+ *   (0) edge_range                                 // lazy random-access sequence of edges over a rank range
+ *   (1) edge_array<T>                              // dense array of T's indexed by edge rank or by (point, point)
+ *
+ *
+ * BINARY STREAMING EXPORT (7):
+ *   (0) binary_kinds                               // EDGE_LIST, CSR_ADJACENCY, or SUBCUBE_LIST
+ *   (1) binary_writer                              // streams varint/delta-coded records to a file in chunks
+ *   (2) binary_reader                              // memory-maps a written file & walks its records in place
+ *   (3) bool write_edge_list(Hypercube, path)      // streams all edges in rank order
+ *   (4) bool write_adjacency_csr(Hypercube, path)  // streams all points' adjacency lists
+ *   (5) bool write_inner_cubes(Hypercube, qnum, path)  // streams all n-cubes w/o materializing them
+ *   (6) bool write_subcubes(subcubes, qnum, path)  // streams the given subcubes
+ *
+ *
+ * RANDOM-FAILURE SIMULATION (4):
+ *   (0) counter_rng                                // counter-based RNG: each draw is a pure fcn of (seed,stream,counter)
+ *   (1) failure_modes                              // VERTEX_FAILURES, EDGE_FAILURES, or VERTEX_AND_EDGE_FAILURES
+ *   (2) percolation_sample                         // one (p,trial) result: giant-component fraction & component-size histogram
+ *   (3) Percolation                                // multithreaded percolation sweeps over failure probabilities p
+ *
+ *
+ * SHARED QUERY RESULT CACHE (3) --- OPT-IN, THREAD-SAFE, LRU BOUNDED BY BYTES:
+ *   (0) query_cache                                // memoizes adjacency matrices, n-cubes & counts by dimension
+ *   (1) query_cache_stats                          // hits, misses, evictions, entries & bytes in use
+ *   (2) query_cache &shared_query_cache()          // process-wide cache instance
+ *
+ *
+ * MESH, RING, & TREE EMBEDDINGS (10):
+ *   (0) qedges mesh_edges(qnums)                   // guest mesh edges (nodes row-major) for the given axis sizes
+ *   (1) qedges ring_edges(qnum)                    // guest ring edges
+ *   (2) qedges tree_edges(qnum)                    // guest complete binary tree edges (nodes in heap order)
+ *   (3) qedges double_rooted_tree_edges(qnum)      // guest double-rooted tree edges (2nd root indexed last)
+ *   (4) qnums  gray_code_mesh_embedding(Hypercube, qnums)  // dilation-1 mesh embedding via per-axis gray codes
+ *   (5) qnums  ring_embedding(Hypercube, qnum)     // ring embedding: a Hamiltonian cycle at length 2^N
+ *   (6) qnums  inorder_tree_embedding(Hypercube, qnum)       // dilation-2 tree embedding via inorder labels
+ *   (7) qnums  double_rooted_tree_embedding(Hypercube, qnum) // dilation-1 spanning double-rooted tree
+ *   (8) embedding_metrics                          // load, expansion, dilation & congestion of an embedding
+ *   (9) embedding_metrics evaluate_embedding(Hypercube, qnums, qedges) // parallel evaluation of any embedding
+ *
+ *
+ * INDUCED SUBGRAPH DISTANCES (2):
+ *   (0) induced_subgraph                           // point-subset bitmap w/ direction-optimizing BFS, eccentricity, & 
+ *                                                  //   64-source bit-parallel all-pairs distances
+ *   (1) distance_distribution                      // all-pairs distance histogram, eccentricities, diameter, etc.
+ *
+ *
+ * OPT-IN INSTRUMENTATION (2) --- COMPILE W/ "-DQGRAPH_INSTRUMENT", ELSE ALL COUNTERS STAY 0 & COST NOTHING:
+ *   (0) inner_cubes_stats                          // per-phase ns timings & hot-path counters of one "inner_cubes" call
+ *   (1) last_inner_cubes_stats()                   // the calling thread's stats from its latest "inner_cubes" call
  */
 
 /******************************************************************************
@@ -204,5 +288,36 @@ int main() {
     cout << "}\n";
   }
 
+  // Finding the largest inner cubes lying fully w/in a set of "healthy" points
+  qnums healthy_points;
+  for(qnum point = 0; point < hcube.total_points(); ++point)
+    if(point != 5 && point != 10) healthy_points.push_back(point);
+  const subcubes largest_healthy = hcube.largest_inner_cubes_within(healthy_points);
+  cout << "\n=> Largest inner cubes w/in dimension " << hcube.dimension 
+       << " avoiding points 5 & 10:\n";
+  for(auto cube : largest_healthy) {
+    cout << "   { ";
+    printlist(hcube.subcube_points(cube));
+    cout << "}\n";
+  }
+
+  /******************************************************************************
+  * RANDOM-FAILURE SIMULATION
+  ******************************************************************************/
+
+  cout << "\n--------------------------\n"
+       << "RANDOM-FAILURE SIMULATION:"
+       << "\n--------------------------\n";
+
+
+  // Sweeping the failure probability of a 12D cube's vertices & edges.
+  // Samples come back in the same order as the given p's.
+  Percolation sim(Hypercube(12), VERTEX_AND_EDGE_FAILURES, /*seed=*/2020);
+  const std::vector<double> failure_probabilities = {0.1, 0.3, 0.5, 0.7};
+  const percolation_samples samples = sim.run_trial(failure_probabilities, /*trial=*/0);
+  for(auto sample : samples)
+    cout << "=> p = " << sample.p << ": " << sample.components << " components, giant fraction = " 
+         << sample.giant_fraction << endl;
+
   return 0;
 }